@@ -0,0 +1,781 @@
+#include "tinyjson.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// the number of heap allocations so far, counted by the replaced `operator new` below
+static std::atomic<size_t> allocation_count{ 0 };
+
+void* operator new(size_t size)
+{
+    ++allocation_count;
+    if (void* ptr = malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    ++allocation_count;
+    size_t align = static_cast<size_t>(alignment);
+    if (void* ptr = aligned_alloc(align, (size + align - 1) / align * align)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { free(ptr); }
+
+namespace
+{
+void get_file_contents(const char* filename, std::string* content)
+{
+    FILE* file = fopen(filename, "rb");
+    if (file == NULL) {
+        std::cerr << "Error: Can't open file: " << filename << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    content->resize(length);
+    size_t bytes = fread((void*)content->data(), sizeof(char), length, file);
+    (void)bytes;
+    fclose(file);
+}
+
+/// generate ~`size` bytes of JSON: an array of records mixing strings, numbers, literals and nested containers
+std::string generate_corpus(size_t size)
+{
+    std::string json = "[";
+    size_t id = 0;
+    while (json.size() < size) {
+        if (id) {
+            json += ",";
+        }
+        json += "\n  {\"id\": " + std::to_string(id) + ", \"name\": \"record number " + std::to_string(id) +
+                "\", \"score\": " + std::to_string(id * 0.25) +
+                ", \"active\": true, \"parent\": null, \"tags\": [\"alpha\", \"beta\", \"gamma\"],"
+                " \"description\": \"a longer string with an \\\"escaped\\\" quote and a tab\\t in the middle\","
+                " \"position\": {\"x\": 1.5, \"y\": -2.75, \"z\": 1e3}}";
+        ++id;
+    }
+    json += "\n]";
+    return json;
+}
+
+/// generate ~`size` bytes of newline delimited JSON records
+std::string generate_ndjson(size_t size)
+{
+    std::string ndjson;
+    size_t id = 0;
+    while (ndjson.size() < size) {
+        ndjson += "{\"id\": " + std::to_string(id) + ", \"level\": \"info\", \"message\": \"request " +
+                  std::to_string(id) + " served\", \"latency\": " + std::to_string(id % 1000 * 0.125) +
+                  ", \"tags\": [\"api\", \"v2\"]}\n";
+        ++id;
+    }
+    return ndjson;
+}
+
+/// generate an array of `count` doubles printed with all their digits
+std::string generate_numbers(size_t count)
+{
+    std::string json = "[";
+    uint64_t state = 88172645463325252ULL;
+    char buffer[64];
+    for (size_t i = 0; i < count; ++i) {
+        // xorshift64
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        double value = static_cast<double>(state >> 11) / static_cast<double>(1ULL << 53) * 2e6 - 1e6;
+        int exponent = static_cast<int>(state % 41) - 20;
+        snprintf(buffer, sizeof(buffer), "%s%.17ge%d", i ? "," : "", value, exponent);
+        json += buffer;
+    }
+    json += "]";
+    return json;
+}
+
+const char* level_name(tinyjson::simd_level level)
+{
+    switch (level) {
+    case tinyjson::simd_level::AVX2:
+        return "avx2";
+    case tinyjson::simd_level::SSE42:
+        return "sse4.2";
+    default:
+        return "scalar";
+    }
+}
+
+/// run `func` `iterations` times and return the best throughput in GB/s
+double measure(size_t bytes, int iterations, const std::function<void()>& func)
+{
+    double best = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        double gbps = static_cast<double>(bytes) / elapsed.count() / 1e9;
+        if (gbps > best) {
+            best = gbps;
+        }
+    }
+    return best;
+}
+
+/// generate ~`size` bytes of JSON: an array of documents, each nested `depth` levels deep (objects and arrays
+/// alternate)
+std::string generate_deep(size_t size, size_t depth = 64)
+{
+    std::string json = "[";
+    size_t id = 0;
+    while (json.size() < size) {
+        json += id ? ",\n  " : "\n  ";
+        for (size_t level = 0; level < depth; ++level) {
+            json += level % 2 ? "[" : "{\"child\": ";
+        }
+        json += std::to_string(id);
+        for (size_t level = depth; level > 0; --level) {
+            json += (level - 1) % 2 ? "]" : "}";
+        }
+        ++id;
+    }
+    json += "\n]";
+    return json;
+}
+
+/// generate ~`size` bytes of JSON: a single object with many members of mixed kinds
+std::string generate_wide(size_t size)
+{
+    std::string json = "{";
+    size_t id = 0;
+    while (json.size() < size) {
+        json += id ? ",\n  \"member_" : "\n  \"member_";
+        json += std::to_string(id) + "\": ";
+        switch (id % 4) {
+        case 0:
+            json += std::to_string(id);
+            break;
+        case 1:
+            json += "\"value " + std::to_string(id) + "\"";
+            break;
+        case 2:
+            json += id % 3 ? "true" : "null";
+            break;
+        default:
+            json += std::to_string(id * 0.5);
+            break;
+        }
+        ++id;
+    }
+    json += "\n}";
+    return json;
+}
+
+/// generate ~`size` bytes of JSON: an array of long strings, with a few escape sequences and non ASCII text
+std::string generate_strings(size_t size)
+{
+    std::string json = "[";
+    size_t id = 0;
+    while (json.size() < size) {
+        json += id ? ",\n  \"" : "\n  \"";
+        for (int i = 0; i < 8; ++i) {
+            json += "the quick brown fox jumps over the lazy dog ";
+        }
+        json += id % 4 ? "caf\\u00e9 \\\\ \\\"done\\\"\"" : "caf\xc3\xa9 line\\n\"";
+        ++id;
+    }
+    json += "\n]";
+    return json;
+}
+
+/// the result of a measurement
+struct result {
+    std::string shape;
+    std::string name;
+    double value = 0.0;
+    std::string unit;
+    /// heap allocations per document, negative when not measured
+    double allocations = -1.0;
+};
+
+/// all the results, for `--json`
+std::vector<result> results;
+/// the input being measured, see `result::shape`
+std::string current_shape;
+
+/// print a result and keep it for `--json`
+void report(const std::string& name, double value, const char* unit, double allocations = -1.0)
+{
+    std::cout << "[" << current_shape << "] " << name << ": " << value << " " << unit;
+    if (allocations >= 0.0) {
+        std::cout << ", " << allocations << " allocations/doc";
+    }
+    std::cout << std::endl;
+    results.push_back({ current_shape, name, value, unit, allocations });
+}
+
+/// write all the results to `path`, as a JSON array
+void write_results(const std::string& path)
+{
+    tinyjson::element root;
+    tinyjson::element::create_array(&root);
+    for (const auto& r : results) {
+        auto& item = root.add_array_object();
+        item.add_property("shape", r.shape).add_property("benchmark", r.name).add_property("value", r.value);
+        item.add_property("unit", r.unit);
+        if (r.allocations >= 0.0) {
+            item.add_property("allocations", r.allocations);
+        }
+    }
+
+    std::ofstream out(path, std::ios_base::binary | std::ios_base::out | std::ios_base::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error: Can't open file: " << path << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    tinyjson::to_string(root, out);
+}
+
+/// the best throughput (in MB/s) of `iterations` runs of `func` over `bytes`, and the heap allocations of a run
+struct measurement {
+    double mbps = 0.0;
+    double allocations = 0.0;
+};
+
+measurement measure_allocations(size_t bytes, int iterations, const std::function<void()>& func)
+{
+    measurement m;
+    for (int i = 0; i < iterations; ++i) {
+        size_t allocations = allocation_count.load();
+        auto start = std::chrono::steady_clock::now();
+        func();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        m.allocations = static_cast<double>(allocation_count.load() - allocations);
+        m.mbps = std::max(m.mbps, static_cast<double>(bytes) / elapsed.count() / 1e6);
+    }
+    return m;
+}
+
+/// the benchmarks run on every generated shape: parsing (from memory and from a file), serialization and lookups
+void run_shape(const std::string& shape, const std::string& content, int iterations)
+{
+    current_shape = shape;
+    auto fail = []() {
+        std::cerr << "parse error" << std::endl;
+        exit(EXIT_FAILURE);
+    };
+
+    measurement m = measure_allocations(content.size(), iterations, [&]() {
+        tinyjson::element root;
+        if (!tinyjson::element::parse(content, &root)) {
+            fail();
+        }
+    });
+    report("element::parse", m.mbps, "MB/s", m.allocations);
+
+    m = measure_allocations(content.size(), iterations, [&]() {
+        tinyjson::document doc;
+        if (!doc.parse(content)) {
+            fail();
+        }
+    });
+    report("document::parse", m.mbps, "MB/s", m.allocations);
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / ("tinyjson_bench_" + shape + ".json");
+    {
+        std::ofstream file(path, std::ios_base::binary | std::ios_base::out | std::ios_base::trunc);
+        file.write(content.data(), content.size());
+    }
+    m = measure_allocations(content.size(), iterations, [&]() {
+        tinyjson::element root;
+        if (!tinyjson::element::parse_file(path.string(), &root)) {
+            fail();
+        }
+    });
+    report("element::parse_file", m.mbps, "MB/s", m.allocations);
+    std::filesystem::remove(path);
+
+    tinyjson::document doc;
+    doc.parse(content);
+    for (bool pretty : { false, true }) {
+        std::string out;
+        tinyjson::to_string(doc.root(), &out, pretty);
+        size_t out_size = out.size();
+        m = measure_allocations(out_size, iterations, [&]() {
+            out.clear();
+            tinyjson::to_string(doc.root(), &out, pretty);
+        });
+        report(pretty ? "to_string (pretty)" : "to_string (compact)", m.mbps, "MB/s", m.allocations);
+    }
+
+    // look up every member of every object by name
+    std::vector<std::pair<const tinyjson::element*, std::string>> lookups;
+    std::function<void(const tinyjson::element&)> collect = [&](const tinyjson::element& e) {
+        for (const auto& child : e) {
+            if (e.is_object()) {
+                lookups.emplace_back(&e, std::string(child.property_name_view()));
+            }
+            collect(child);
+        }
+    };
+    collect(doc.root());
+    if (!lookups.empty()) {
+        // the first lookup builds the name index of large objects
+        size_t found = 0;
+        m = measure_allocations(lookups.size(), iterations, [&]() {
+            for (const auto& [object, name] : lookups) {
+                found += object->contains(name);
+            }
+        });
+        if (found == 0) {
+            fail();
+        }
+        report("element::contains", m.mbps, "M lookups/s");
+    }
+}
+
+/// the records of `generate_corpus`, for the typed binding
+struct point {
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+};
+
+struct record {
+    int64_t id = 0;
+    std::string name;
+    double score = 0.0;
+    bool active = false;
+    std::optional<std::string> parent;
+    std::vector<std::string> tags;
+    std::string description;
+    point position;
+};
+} // namespace
+
+TINYJSON_BIND(point, x, y, z)
+TINYJSON_BIND(record, id, name, score, active, parent, tags, description, position)
+
+int main(int argc, char** argv)
+{
+    // usage: tinyjson_bench [--json <results.json>] [input.json]
+    const char* input_path = nullptr;
+    const char* json_path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else {
+            input_path = argv[i];
+        }
+    }
+
+    std::string content;
+    if (input_path) {
+        get_file_contents(input_path, &content);
+        current_shape = input_path;
+    } else {
+        content = generate_corpus(64 * 1024 * 1024);
+        current_shape = "records";
+    }
+
+    constexpr int ITERATIONS = 5;
+    std::cout << "input: " << content.size() << " bytes" << std::endl;
+
+    std::vector<tinyjson::simd_level> levels = { tinyjson::simd_level::SCALAR };
+    if (tinyjson::detect_simd_level() >= tinyjson::simd_level::SSE42) {
+        levels.push_back(tinyjson::simd_level::SSE42);
+    }
+    if (tinyjson::detect_simd_level() >= tinyjson::simd_level::AVX2) {
+        levels.push_back(tinyjson::simd_level::AVX2);
+    }
+
+    std::vector<uint32_t> index;
+    for (auto level : levels) {
+        tinyjson::set_simd_level(level);
+        double gbps = measure(content.size(), ITERATIONS,
+                              [&]() { tinyjson::build_structural_index(content.data(), content.size(), &index); });
+        report(std::string("structural index (") + level_name(level) + ")", gbps, "GB/s");
+    }
+
+    // `SCALAR` parses without the structural index
+    for (auto level : levels) {
+        tinyjson::set_simd_level(level);
+        double gbps = measure(content.size(), ITERATIONS, [&]() {
+            tinyjson::document doc;
+            if (!doc.parse(content)) {
+                std::cerr << "parse error" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        });
+        report(std::string("document::parse (") + level_name(level) + ")", gbps, "GB/s");
+    }
+    tinyjson::set_simd_level(tinyjson::detect_simd_level());
+
+    // the elements of the top-level array on all cores
+    {
+        double gbps = measure(content.size(), ITERATIONS, [&]() {
+            tinyjson::document doc;
+            if (!doc.parse_parallel(content)) {
+                std::cerr << "parse error" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        });
+        report("document::parse_parallel", gbps, "GB/s");
+    }
+
+    // lazy parsing, reading a single field of a single record
+    {
+        double gbps = measure(content.size(), ITERATIONS, [&]() {
+            tinyjson::document doc;
+            if (!doc.parse_lazy(content) || !doc.root()[0]["id"].is_integer()) {
+                std::cerr << "parse error" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        });
+        report("document::parse_lazy (one field)", gbps, "GB/s");
+    }
+
+    // the compact read-only layout, then a full walk of both trees
+    {
+        tinyjson::tape_document tape;
+        double gbps = measure(content.size(), ITERATIONS, [&]() {
+            if (!tape.parse(content)) {
+                std::cerr << "parse error" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        });
+        report("tape_document::parse", gbps, "GB/s");
+        report("tape_document::memory_usage", static_cast<double>(tape.memory_usage()), "bytes");
+
+        tinyjson::document doc;
+        doc.parse(content);
+        std::function<size_t(const tinyjson::element&)> walk_element = [&](const tinyjson::element& e) {
+            size_t count = 1;
+            for (const auto& child : e) {
+                count += walk_element(child);
+            }
+            return count;
+        };
+        std::function<size_t(const tinyjson::tape_element&)> walk_tape = [&](const tinyjson::tape_element& e) {
+            size_t count = 1;
+            for (const auto& child : e) {
+                count += walk_tape(child);
+            }
+            return count;
+        };
+        gbps = measure(content.size(), ITERATIONS, [&]() { walk_element(doc.root()); });
+        report("walk (element)", gbps, "GB/s");
+        gbps = measure(content.size(), ITERATIONS, [&]() { walk_tape(tape.root()); });
+        report("walk (tape_element)", gbps, "GB/s");
+
+        // lookups by name, in every object of the top-level array
+        constexpr int LOOKUP_ROUNDS = 10;
+        const char* names[] = { "id", "name", "position", "missing" };
+        size_t lookups = 0;
+        for (const auto& record : doc.root()) {
+            lookups += record.is_object() ? LOOKUP_ROUNDS * 4 : 0;
+        }
+        gbps = measure(lookups, ITERATIONS, [&]() {
+            size_t found = 0;
+            for (int round = 0; round < LOOKUP_ROUNDS; ++round) {
+                for (const auto& record : doc.root()) {
+                    for (const char* name : names) {
+                        found += record.contains(name);
+                    }
+                }
+            }
+            if (found == 1) {
+                std::cout << found << std::endl;
+            }
+        });
+        report("element::contains", gbps * 1e3, "M lookups/s");
+
+        // the same names, hashed once
+        static constexpr tinyjson::property_key keys[] = { tinyjson::property_key("id"),
+            tinyjson::property_key("name"), tinyjson::property_key("position"), tinyjson::property_key("missing") };
+        gbps = measure(lookups, ITERATIONS, [&]() {
+            size_t found = 0;
+            for (int round = 0; round < LOOKUP_ROUNDS; ++round) {
+                for (const auto& record : doc.root()) {
+                    for (const auto& key : keys) {
+                        found += record.contains(key);
+                    }
+                }
+            }
+            if (found == 1) {
+                std::cout << found << std::endl;
+            }
+        });
+        report("element::contains (property_key)", gbps * 1e3, "M lookups/s");
+    }
+
+    // straight from the (memory mapped) file
+    if (input_path) {
+        double gbps = measure(content.size(), ITERATIONS, [&]() {
+            tinyjson::document doc;
+            if (!doc.parse_file(input_path)) {
+                std::cerr << "parse error" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        });
+        report("document::parse_file", gbps, "GB/s");
+
+        gbps = measure(content.size(), ITERATIONS, [&]() {
+            tinyjson::document doc;
+            if (!doc.parse_file_view(input_path)) {
+                std::cerr << "parse error" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        });
+        report("document::parse_file_view", gbps, "GB/s");
+    }
+
+    // SAX parsing (no tree), counting the values
+    {
+        struct counter : tinyjson::handler {
+            size_t values = 0;
+            bool count()
+            {
+                ++values;
+                return true;
+            }
+            bool null_value() override { return count(); }
+            bool bool_value(bool) override { return count(); }
+            bool int64_value(int64_t) override { return count(); }
+            bool uint64_value(uint64_t) override { return count(); }
+            bool double_value(double) override { return count(); }
+            bool string_value(std::string_view) override { return count(); }
+        };
+        double gbps = measure(content.size(), ITERATIONS, [&]() {
+            counter h;
+            if (!tinyjson::parse(std::string_view(content), &h)) {
+                std::cerr << "parse error" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        });
+        report("parse (handler)", gbps, "GB/s");
+
+        // the same, with the input arriving in 64KB chunks
+        constexpr size_t CHUNK_SIZE = 64 * 1024;
+        gbps = measure(content.size(), ITERATIONS, [&]() {
+            counter h;
+            tinyjson::push_parser parser(&h);
+            for (size_t offset = 0; offset < content.size(); offset += CHUNK_SIZE) {
+                parser.feed(content.data() + offset, std::min(CHUNK_SIZE, content.size() - offset));
+            }
+            if (!parser.finish()) {
+                std::cerr << "parse error" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        });
+        report("push_parser (handler, 64KB chunks)", gbps, "GB/s");
+    }
+
+    // NDJSON, single threaded and with a thread per core
+    {
+        std::string ndjson = generate_ndjson(64 * 1024 * 1024);
+        for (size_t threads : { size_t(1), size_t(0) }) {
+            double gbps = measure(ndjson.size(), ITERATIONS, [&]() {
+                size_t records = 0;
+                tinyjson::parse_result ok = tinyjson::parse_ndjson(
+                    ndjson,
+                    [&](size_t, const tinyjson::element&) {
+                        ++records;
+                        return true;
+                    },
+                    threads);
+                if (!ok || records == 0) {
+                    std::cerr << "parse error" << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+            });
+            report(std::string("parse_ndjson (") + (threads ? "1 thread" : "all cores") + ")", gbps, "GB/s");
+        }
+    }
+
+    // typed binding, on the generated records: straight into structs, and through a tree for comparison
+    if (!input_path) {
+        std::vector<record> records;
+        double gbps = measure(content.size(), ITERATIONS, [&]() {
+            if (!tinyjson::from_json(content, &records)) {
+                std::cerr << "parse error" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        });
+        report("from_json", gbps, "GB/s");
+
+        gbps = measure(content.size(), ITERATIONS, [&]() {
+            tinyjson::document doc;
+            doc.parse(content);
+            records.clear();
+            for (const auto& item : doc.root()) {
+                record& r = records.emplace_back();
+                r.id = item["id"].to_int64();
+                item["name"].as_str(&r.name);
+                r.score = item["score"].to_number<double>();
+                r.active = item["active"].to_bool();
+                if (item["parent"].is_string()) {
+                    r.parent = item["parent"].to_str<std::string>();
+                }
+                for (const auto& tag : item["tags"]) {
+                    r.tags.push_back(tag.to_str<std::string>());
+                }
+                item["description"].as_str(&r.description);
+                r.position.x = item["position"]["x"].to_number<double>();
+                r.position.y = item["position"]["y"].to_number<double>();
+                r.position.z = item["position"]["z"].to_number<double>();
+            }
+        });
+        report("document::parse + copy into structs", gbps, "GB/s");
+
+        std::string out;
+        tinyjson::to_json(records, &out);
+        size_t out_size = out.size();
+        gbps = measure(out_size, ITERATIONS, [&]() {
+            out.clear();
+            tinyjson::to_json(records, &out);
+        });
+        report("to_json", gbps, "GB/s");
+    }
+
+    // a compiled query, on a tree and while parsing
+    {
+        tinyjson::query query;
+        query.compile("$[*].position.x");
+        tinyjson::document doc;
+        doc.parse(content);
+        std::vector<const tinyjson::element*> matches;
+        double gbps = measure(content.size(), ITERATIONS, [&]() {
+            matches.clear();
+            query.select(doc.root(), &matches);
+        });
+        report("query::select (tree)", gbps, "GB/s");
+
+        gbps = measure(content.size(), ITERATIONS, [&]() {
+            size_t count = 0;
+            if (!query.select(content, [&count](const tinyjson::element&) { return ++count > 0; })) {
+                std::cerr << "parse error" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        });
+        report("query::select (streaming)", gbps, "GB/s");
+    }
+
+    // serialization (compact), reusing the output buffer between iterations
+    {
+        tinyjson::document doc;
+        doc.parse(content);
+        std::string out;
+        tinyjson::to_string(doc.root(), &out, false);
+        size_t out_size = out.size();
+        double gbps = measure(out_size, ITERATIONS, [&]() {
+            out.clear();
+            tinyjson::to_string(doc.root(), &out, false);
+        });
+        report("to_string (string)", gbps, "GB/s");
+
+        gbps = measure(out_size, ITERATIONS, [&]() {
+            std::stringstream ss;
+            tinyjson::to_string(doc.root(), ss, false);
+        });
+        report("to_string (ostream)", gbps, "GB/s");
+    }
+
+    // escaping: mostly plain text with an occasional quote or newline
+    {
+        std::string text;
+        while (text.size() < 16 * 1024 * 1024) {
+            text += "the quick brown fox jumps over the lazy dog, ";
+            text += (text.size() % 7 == 0) ? "\"quoted\"\n" : "nothing to escape here. ";
+        }
+        std::string escaped;
+        for (auto level : levels) {
+            tinyjson::set_simd_level(level);
+            double gbps = measure(text.size(), ITERATIONS, [&]() { tinyjson::escape_string(text, &escaped); });
+            report(std::string("escape_string (") + level_name(level) + ")", gbps, "GB/s");
+        }
+        tinyjson::set_simd_level(tinyjson::detect_simd_level());
+    }
+
+    // number heavy input
+    constexpr size_t NUMBERS_COUNT = 10 * 1000 * 1000;
+    std::string numbers = generate_numbers(NUMBERS_COUNT);
+    double gbps = measure(numbers.size(), 3, [&]() {
+        tinyjson::element root;
+        if (!tinyjson::parse(numbers, &root) || root.size() != NUMBERS_COUNT) {
+            std::cerr << "parse error" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    });
+    report("element::parse (doubles)", gbps, "GB/s");
+    report("element::parse (doubles)", gbps * 1e9 / (numbers.size() / static_cast<double>(NUMBERS_COUNT)) / 1e6,
+           "M numbers/s");
+
+    // for reference: the conversion alone, with `strtod`
+    gbps = measure(numbers.size(), 3, [&]() {
+        const char* ptr = numbers.c_str() + 1;
+        double sum = 0.0;
+        for (size_t i = 0; i < NUMBERS_COUNT; ++i) {
+            char* end = nullptr;
+            sum += strtod(ptr, &end);
+            ptr = end + 1;
+        }
+        if (sum == 0.1) {
+            std::cout << sum << std::endl;
+        }
+    });
+    report("strtod (doubles)", gbps, "GB/s");
+
+    // the same benchmarks on documents of different shapes, with their allocations
+    constexpr size_t SHAPE_SIZE = 16 * 1024 * 1024;
+    run_shape("records", generate_corpus(SHAPE_SIZE), ITERATIONS);
+    run_shape("deep", generate_deep(SHAPE_SIZE), ITERATIONS);
+    run_shape("wide", generate_wide(SHAPE_SIZE), ITERATIONS);
+    run_shape("strings", generate_strings(SHAPE_SIZE), ITERATIONS);
+    run_shape("numbers", generate_numbers(SHAPE_SIZE / 24), ITERATIONS);
+
+    // NDJSON: the allocations are per record
+    {
+        current_shape = "ndjson";
+        std::string ndjson = generate_ndjson(SHAPE_SIZE);
+        size_t records = 0;
+        measurement m = measure_allocations(ndjson.size(), ITERATIONS, [&]() {
+            records = 0;
+            tinyjson::parse_result ok = tinyjson::parse_ndjson(ndjson, [&](size_t, const tinyjson::element&) {
+                ++records;
+                return true;
+            });
+            if (!ok) {
+                std::cerr << "parse error" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        });
+        report("parse_ndjson", m.mbps, "MB/s", m.allocations / std::max<size_t>(records, 1));
+    }
+
+    if (json_path) {
+        write_results(json_path);
+    }
+    return 0;
+}
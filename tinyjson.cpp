@@ -1,643 +1,5149 @@
-#include "tinyjson.hpp"
-
-#include <cmath>
-#include <cstdio>
-#include <cstdlib>
-#include <cstring>
-#include <sstream>
-#include <string_view>
-#include <utility>
-
-namespace tinyjson
-{
-/* Utility to jump whitespace and cr/lf */
-const char* skip(const char* in)
-{
-    while (in && *in && (unsigned char)*in <= 32)
-        in++;
-    return in;
-}
-
-/* Parse the input text into an unescaped cstring, and populate item. */
-thread_local const unsigned char firstByteMark[7] = { 0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC };
-
-/// escape `in` to a printable version
-std::string& escape_string(const std::string_view& str, std::string* escaped)
-{
-    const char* ptr = nullptr;
-    char *ptr2 = nullptr, *out = nullptr;
-    int len = 0;
-    unsigned char token;
-
-    if (str.empty()) {
-        return *escaped;
-    }
-
-    ptr = str.data();
-    while ((token = *ptr) && ++len) {
-        if (strchr("\"\\\b\f\n\r\t", token))
-            len++;
-        else if (token < 32)
-            len += 5;
-        ptr++;
-    }
-
-    escaped->resize(len + 2);
-    out = escaped->data();
-
-    ptr2 = out;
-    ptr = str.data();
-    *ptr2++ = '\"';
-    while (*ptr) {
-        if ((unsigned char)*ptr > 31 && *ptr != '\"' && *ptr != '\\')
-            *ptr2++ = *ptr++;
-        else {
-            *ptr2++ = '\\';
-            switch (token = *ptr++) {
-            case '\\':
-                *ptr2++ = '\\';
-                break;
-            case '\"':
-                *ptr2++ = '\"';
-                break;
-            case '\b':
-                *ptr2++ = 'b';
-                break;
-            case '\f':
-                *ptr2++ = 'f';
-                break;
-            case '\n':
-                *ptr2++ = 'n';
-                break;
-            case '\r':
-                *ptr2++ = 'r';
-                break;
-            case '\t':
-                *ptr2++ = 't';
-                break;
-            default:
-                snprintf(ptr2, 6, "u%04x", token);
-                ptr2 += 6;
-                break; /* escape and print */
-            }
-        }
-    }
-    *ptr2++ = '\"';
-    return *escaped;
-}
-
-const char* element::parse_string(tinyjson::element* item, const char* str)
-{
-    const char* ptr = str + 1;
-    char* ptr2;
-    int len = 0;
-    unsigned uc, uc2;
-    if (*str != '\"') {
-        return nullptr;
-    } /* not a string! */
-
-    while (*ptr != '\"' && *ptr && ++len)
-        if (*ptr++ == '\\')
-            ptr++; /* Skip escaped quotes. */
-
-    char* out = (char*)malloc(len + 1);
-    ptr = str + 1;
-    ptr2 = out;
-
-    while (*ptr != '\"' && *ptr) {
-        if (*ptr != '\\')
-            *ptr2++ = *ptr++;
-        else {
-            ptr++;
-            switch (*ptr) {
-            case 'b':
-                *ptr2++ = '\b';
-                break;
-            case 'f':
-                *ptr2++ = '\f';
-                break;
-            case 'n':
-                *ptr2++ = '\n';
-                break;
-            case 'r':
-                *ptr2++ = '\r';
-                break;
-            case 't':
-                *ptr2++ = '\t';
-                break;
-            case 'u': /* transcode utf16 to utf8. */
-                sscanf(ptr + 1, "%4x", &uc);
-                ptr += 4; /* get the unicode char. */
-
-                if ((uc >= 0xDC00 && uc <= 0xDFFF) || uc == 0)
-                    break; // check for invalid.
-
-                if (uc >= 0xD800 && uc <= 0xDBFF) // UTF16 surrogate pairs.
-                {
-                    if (ptr[1] != '\\' || ptr[2] != 'u')
-                        break; // missing second-half of surrogate.
-                    sscanf(ptr + 3, "%4x", &uc2);
-                    ptr += 6;
-                    if (uc2 < 0xDC00 || uc2 > 0xDFFF)
-                        break; // invalid second-half of surrogate.
-                    uc = 0x10000 | ((uc & 0x3FF) << 10) | (uc2 & 0x3FF);
-                }
-
-                len = 4;
-                if (uc < 0x80)
-                    len = 1;
-                else if (uc < 0x800)
-                    len = 2;
-                else if (uc < 0x10000)
-                    len = 3;
-                ptr2 += len;
-
-                switch (len) {
-                case 4:
-                    *--ptr2 = ((uc | 0x80) & 0xBF);
-                    uc >>= 6;
-                case 3:
-                    *--ptr2 = ((uc | 0x80) & 0xBF);
-                    uc >>= 6;
-                case 2:
-                    *--ptr2 = ((uc | 0x80) & 0xBF);
-                    uc >>= 6;
-                case 1:
-                    *--ptr2 = (uc | firstByteMark[len]);
-                }
-                ptr2 += len;
-                break;
-            default:
-                *ptr2++ = *ptr;
-                break;
-            }
-            ptr++;
-        }
-    }
-    *ptr2 = 0;
-    if (*ptr == '\"')
-        ptr++;
-
-    item->m_value.str = out;
-    item->m_kind = tinyjson::element_kind::T_STRING;
-    return ptr;
-}
-
-element::~element()
-{
-    m_elements_map.clear();
-    m_children.clear();
-
-    if (m_kind == element_kind::T_STRING && m_value.str) {
-        free(m_value.str);
-        m_value.str = nullptr;
-    }
-}
-
-element::element() { memset(&m_value, 0, sizeof(m_value)); }
-element::element(element&& other)
-{
-    m_kind = other.m_kind;
-    m_elements_map.clear();
-    m_property_name = std::move(other.m_property_name);
-    m_value = other.m_value;
-    if (other.m_kind == element_kind::T_STRING) {
-        // ensure that no double free is occured
-        other.m_value.str = nullptr;
-    }
-    m_children = std::move(other.m_children);
-    m_elements_map = std::move(other.m_elements_map);
-}
-
-/* Parse the input text to generate a number, and populate the result into item. */
-const char* element::parse_number(tinyjson::element* item, const char* num)
-{
-    double n = 0, sign = 1, scale = 0;
-    int subscale = 0, signsubscale = 1;
-
-    /* Could use sscanf for this? */
-    if (*num == '-')
-        sign = -1, num++; /* Has sign? */
-    if (*num == '0')
-        num++; /* is zero */
-    if (*num >= '1' && *num <= '9')
-        do
-            n = (n * 10.0) + (*num++ - '0');
-        while (*num >= '0' && *num <= '9'); /* Number? */
-    if (*num == '.' && num[1] >= '0' && num[1] <= '9') {
-        num++;
-        do
-            n = (n * 10.0) + (*num++ - '0'), scale--;
-        while (*num >= '0' && *num <= '9');
-    }                               /* Fractional part? */
-    if (*num == 'e' || *num == 'E') /* Exponent? */
-    {
-        num++;
-        if (*num == '+')
-            num++;
-        else if (*num == '-')
-            signsubscale = -1, num++; /* With sign? */
-        while (*num >= '0' && *num <= '9')
-            subscale = (subscale * 10) + (*num++ - '0'); /* Number? */
-    }
-
-    n = sign * n * pow(10.0, (scale + subscale * signsubscale)); /* number = +/- number.fraction * 10^+/- exponent */
-
-    item->m_kind = tinyjson::element_kind::T_NUMBER;
-    item->m_value.number = n;
-    return num;
-}
-
-/* Build an array from input text. */
-const char* element::parse_array(tinyjson::element* item, const char* value)
-{
-    if (*value != '[') {
-        return nullptr;
-    } /* not an array! */
-
-    item->m_kind = tinyjson::element_kind::T_ARRAY;
-    value = skip(value + 1);
-    if (*value == ']')
-        return value + 1; /* empty array. */
-
-    auto& child = item->append_new();
-
-    value = skip(parse_value(&child, skip(value))); /* skip any spacing, get the value. */
-    if (!value)
-        return nullptr;
-
-    while (*value == ',') {
-        auto& child = item->append_new();
-        value = skip(parse_value(&child, skip(value + 1)));
-        if (!value)
-            return nullptr; /* memory fail */
-    }
-
-    if (*value == ']')
-        return value + 1; /* end of array */
-
-    return nullptr; /* malformed. */
-}
-
-/* Build an object from the text. */
-const char* element::parse_object(tinyjson::element* item, const char* value)
-{
-    if (*value != '{') {
-        return nullptr;
-    } // not an object
-
-    item->m_kind = tinyjson::element_kind::T_OBJECT;
-    value = skip(value + 1);
-    if (*value == '}')
-        return value + 1; // empty object
-
-    auto& child = item->append_new();
-    value = skip(parse_string(&child, skip(value)));
-
-    if (!value) {
-        return nullptr;
-    }
-
-    // parse the property name
-    child.m_property_name = child.m_value.str;
-    free(child.m_value.str);
-    child.m_value.str = nullptr;
-
-    if (*value != ':') {
-        // parse error
-        return nullptr;
-    }
-
-    // parse the property value
-    value = skip(parse_value(&child, skip(value + 1))); /* skip any spacing, get the value. */
-    if (!value)
-        return nullptr;
-
-    while (*value == ',') {
-        auto& child = item->append_new();
-        value = skip(parse_string(&child, skip(value + 1)));
-
-        if (!value) {
-            return nullptr;
-        }
-
-        child.m_property_name = child.m_value.str;
-        free(child.m_value.str);
-        child.m_value.str = nullptr;
-        if (*value != ':') {
-            // parse error
-            return nullptr;
-        }
-
-        // parse the property value
-        value = skip(parse_value(&child, skip(value + 1))); /* skip any spacing, get the value. */
-        if (!value)
-            return nullptr;
-    }
-
-    if (*value == '}')
-        return value + 1; /* end of array */
-    return nullptr;       /* malformed. */
-}
-
-const char* element::parse_value(tinyjson::element* item, const char* value)
-{
-    if (!value)
-        return nullptr; /* Fail on null. */
-    if (!strncmp(value, "null", 4)) {
-        item->m_kind = tinyjson::element_kind::T_NULL;
-        return value + 4;
-    }
-
-    if (!strncmp(value, "false", 5)) {
-        item->m_kind = tinyjson::element_kind::T_FALSE;
-        return value + 5;
-    }
-
-    if (!strncmp(value, "true", 4)) {
-        item->m_kind = tinyjson::element_kind::T_TRUE;
-        return value + 4;
-    }
-
-    if (*value == '\"') {
-        return parse_string(item, value);
-    }
-
-    if (*value == '-' || (*value >= '0' && *value <= '9')) {
-        return parse_number(item, value);
-    }
-
-    if (*value == '[') {
-        return parse_array(item, value);
-    }
-
-    if (*value == '{') {
-        return parse_object(item, value);
-    }
-
-    return nullptr; /* failure. */
-}
-
-void element::index_elements()
-{
-    if (!m_children.empty()) {
-        m_elements_map.reserve(m_children.size());
-        for (auto& child : m_children) {
-            if (child.property_name()) {
-                m_elements_map.emplace(std::make_pair(child.property_name(), &child));
-            }
-        }
-    }
-}
-
-bool element::create_array(element* arr)
-{
-    arr->m_kind = element_kind::T_ARRAY;
-    return true;
-}
-
-bool element::create_object(element* obj)
-{
-    obj->m_kind = element_kind::T_OBJECT;
-    return true;
-}
-
-bool element::parse(const std::string& content, element* root)
-{
-    if (!element::parse_value(root, skip(content.c_str()))) {
-        return false;
-    }
-    return true;
-}
-
-bool element::parse_file(const std::string& path, element* root)
-{
-    // read the file content
-    std::string content;
-    FILE* file = fopen(path.c_str(), "rb");
-    // Check if there was an error.
-    if (file == nullptr) {
-        return false;
-    }
-
-    // Get the file length
-    fseek(file, 0, SEEK_END);
-    auto length = ftell(file);
-    fseek(file, 0, SEEK_SET);
-
-    content.resize(length);
-    // Set the contents of the string.
-    size_t bytes = fread(content.data(), sizeof(char), length, file);
-
-    // no need for the file pointer any more, close it
-    fclose(file);
-
-    // did we read all the file?
-    if (bytes != length) {
-        return false;
-    }
-
-    return parse(content, root);
-}
-
-thread_local element null_element;
-
-const element& element::operator[](const char* index) const
-{
-    if (m_children.empty()) {
-        return null_element;
-    }
-
-    if (m_elements_map.empty()) {
-        // need to index it first
-        const_cast<element&>(*this).index_elements();
-    }
-
-    if (m_elements_map.count(index) == 0) {
-        return null_element;
-    }
-    return *m_elements_map.find(index)->second;
-}
-
-element& element::operator[](const char* index)
-{
-    if (m_children.empty()) {
-        return null_element;
-    }
-
-    if (m_elements_map.empty()) {
-        // need to index it first
-        const_cast<element&>(*this).index_elements();
-    }
-
-    if (m_elements_map.count(index) == 0) {
-        return null_element;
-    }
-    auto& elem = *m_elements_map.find(index)->second;
-    return elem;
-}
-
-const element& element::operator[](size_t index) const
-{
-    if (index >= m_children.size()) {
-        return null_element;
-    }
-    return m_children[index];
-}
-
-element& element::operator[](size_t index)
-{
-    if (index >= m_children.size()) {
-        return null_element;
-    }
-    return m_children[index];
-}
-
-element& element::add_property_internal(const std::string& name)
-{
-    auto& elem = append_new();
-    elem.m_property_name = name;
-
-    // add new indexed entry
-    if (elem.property_name()) {
-        m_elements_map.insert({ elem.property_name(), &elem });
-    }
-    return elem;
-}
-
-element& element::add_element(element&& elem)
-{
-    m_children.emplace_back(std::move(elem));
-    auto& item_added = m_children.back();
-    if (item_added.property_name()) {
-        m_elements_map.insert({ item_added.property_name(), &item_added });
-    }
-    return item_added;
-}
-
-element& element::add_array(const std::string& name)
-{
-    element arr;
-    create_array(&arr);
-    arr.m_property_name = name;
-    return add_element(std::move(arr));
-}
-
-element& element::add_object(const std::string& name)
-{
-    element obj;
-    create_object(&obj);
-    obj.m_property_name = name;
-    return add_element(std::move(obj));
-}
-
-element& element::add_property(const std::string& name, int value)
-{
-    return add_property(name, static_cast<double>(value));
-}
-
-element& element::add_property(const std::string& name, long value)
-{
-    return add_property(name, static_cast<double>(value));
-}
-
-element& element::add_property(const std::string& name, size_t value)
-{
-    return add_property(name, static_cast<double>(value));
-}
-
-element& element::add_property(const std::string& name, double value)
-{
-    auto& elem = add_property_internal(name);
-    elem.m_value.number = value;
-    elem.m_kind = element_kind::T_NUMBER;
-    return *this;
-}
-
-element& element::add_property(const std::string& name, const std::string& value)
-{
-    auto& elem = add_property_internal(name);
-    elem.m_value.str = strdup(value.c_str());
-    elem.m_kind = element_kind::T_STRING;
-    return *this;
-}
-
-element& element::add_property(const std::string& name, const char* value)
-{
-    auto& elem = add_property_internal(name);
-    elem.m_value.str = strdup(value);
-    elem.m_kind = element_kind::T_STRING;
-    return *this;
-}
-
-element& element::add_property(const std::string& name, bool b)
-{
-    auto& elem = add_property_internal(name);
-    elem.m_value.boolean = b;
-    elem.m_kind = b ? element_kind::T_TRUE : element_kind::T_FALSE;
-    return *this;
-}
-
-element& element::add_property_null(const std::string& name)
-{
-    auto& elem = add_property_internal(name);
-    elem.m_kind = element_kind::T_NULL;
-    return *this;
-}
-
-element& element::add_array_item(const std::string& value)
-{
-    auto& elem = add_property_internal("");
-    elem.m_kind = element_kind::T_STRING;
-    elem.m_value.str = strdup(value.c_str());
-    return *this;
-}
-
-element& element::add_array_item(const char* value)
-{
-    auto& elem = add_property_internal("");
-    elem.m_kind = element_kind::T_STRING;
-    elem.m_value.str = strdup(value);
-    return *this;
-}
-
-element& element::add_array_item(double value)
-{
-    auto& elem = add_property_internal("");
-    elem.m_kind = element_kind::T_NUMBER;
-    elem.m_value.number = value;
-    return *this;
-}
-
-element& element::add_array_item(bool value)
-{
-    auto& elem = add_property_internal("");
-    elem.m_kind = value ? element_kind::T_TRUE : element_kind::T_FALSE;
-    elem.m_value.boolean = value;
-    return *this;
-}
-
-element& element::add_array_item(element elem) { return add_element(std::move(elem)); }
-
-element& element::add_array_object()
-{
-    auto& elem = append_new();
-    elem.m_kind = element_kind::T_OBJECT;
-    return elem;
-}
-
-bool element::contains(const char* name) const
-{
-    if (m_children.empty()) {
-        return false;
-    }
-    if (m_elements_map.empty()) {
-        // need to index it first
-        const_cast<element&>(*this).index_elements();
-    }
-    return m_elements_map.count(std::string(name)) > 0;
-}
-
-bool element::contains(const std::string& name) const { return contains(name.c_str()); }
-
-} // namespace tinyjson
+#include "tinyjson.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cfloat>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#if TINYJSON_X86
+#include <immintrin.h>
+#endif
+
+#if defined(_WIN32)
+#define TINYJSON_MMAP 0
+#else
+#define TINYJSON_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tinyjson
+{
+/* Utility to jump whitespace and cr/lf */
+const char* skip(const char* in, const char* end)
+{
+    while (in && in < end && *in && (unsigned char)*in <= 32)
+        in++;
+    return in;
+}
+
+// ----------------------------------------------------------------------------
+// Statistics
+// ----------------------------------------------------------------------------
+
+thread_local parse_stats current_stats;
+
+const parse_stats& get_parse_stats() { return current_stats; }
+
+void reset_parse_stats() { current_stats = parse_stats(); }
+
+#if TINYJSON_STATS
+/// `statement` is only compiled when collecting statistics
+#define TINYJSON_STAT(...) __VA_ARGS__
+
+/// add the time spent in its scope to a `parse_stats` counter
+struct stats_timer {
+    uint64_t& total;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    ~stats_timer()
+    {
+        total += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+/// count an allocation of `bytes` for a tree
+FLATTEN_INLINE void count_allocation(size_t bytes)
+{
+    ++current_stats.allocations;
+    current_stats.allocated_bytes += bytes;
+}
+
+/// add the statistics collected by another thread to `into`
+void merge_parse_stats(parse_stats& into, const parse_stats& from)
+{
+    into.bytes_parsed += from.bytes_parsed;
+    into.bytes_serialized += from.bytes_serialized;
+    for (size_t kind = 0; kind < std::size(into.nodes); ++kind) {
+        into.nodes[kind] += from.nodes[kind];
+    }
+    into.max_depth = std::max(into.max_depth, from.max_depth);
+    into.unescaped_bytes += from.unescaped_bytes;
+    into.allocations += from.allocations;
+    into.allocated_bytes += from.allocated_bytes;
+    into.index_ns += from.index_ns;
+    into.parse_ns += from.parse_ns;
+    into.serialize_ns += from.serialize_ns;
+}
+#else
+#define TINYJSON_STAT(...)
+#endif
+
+// ----------------------------------------------------------------------------
+// Structural index (stage 1)
+// ----------------------------------------------------------------------------
+//
+// The input is classified in 64 byte blocks into bitmasks (quotes, backslashes, structural characters and
+// whitespace). The bitmasks are then combined to find the escaped quotes and the string ranges, and the
+// offsets of all the tokens outside of strings are written into the index. The parser uses the index to
+// jump from one token to the next and to find the end of strings without looking at the bytes in between
+
+#if TINYJSON_X86
+static bool cpu_has_avx2() { return __builtin_cpu_supports("avx2"); }
+static bool cpu_has_sse42() { return __builtin_cpu_supports("sse4.2"); }
+#endif
+
+simd_level detect_simd_level()
+{
+#if TINYJSON_X86
+    __builtin_cpu_init();
+    if (cpu_has_avx2()) {
+        return simd_level::AVX2;
+    }
+    if (cpu_has_sse42()) {
+        return simd_level::SSE42;
+    }
+#endif
+    return simd_level::SCALAR;
+}
+
+static std::atomic<simd_level>& active_simd_level()
+{
+    static std::atomic<simd_level> level{ detect_simd_level() };
+    return level;
+}
+
+simd_level get_simd_level() { return active_simd_level().load(std::memory_order_relaxed); }
+
+void set_simd_level(simd_level level)
+{
+    simd_level best = detect_simd_level();
+    active_simd_level().store(static_cast<int>(level) > static_cast<int>(best) ? best : level,
+                              std::memory_order_relaxed);
+}
+
+// the fields of the `parse_limits` in use, atomic so they can be changed while other threads parse. They are read
+// once at the start of every parse
+static std::atomic<size_t> max_depth_limit{ parse_limits{}.max_depth };
+static std::atomic<size_t> max_document_size_limit{ parse_limits{}.max_document_size };
+static std::atomic<size_t> max_string_length_limit{ parse_limits{}.max_string_length };
+static std::atomic<size_t> max_elements_limit{ parse_limits{}.max_elements };
+
+parse_limits get_parse_limits()
+{
+    parse_limits limits;
+    limits.max_depth = max_depth_limit.load(std::memory_order_relaxed);
+    limits.max_document_size = max_document_size_limit.load(std::memory_order_relaxed);
+    limits.max_string_length = max_string_length_limit.load(std::memory_order_relaxed);
+    limits.max_elements = max_elements_limit.load(std::memory_order_relaxed);
+    return limits;
+}
+
+void set_parse_limits(const parse_limits& limits)
+{
+    max_depth_limit.store(limits.max_depth, std::memory_order_relaxed);
+    max_document_size_limit.store(limits.max_document_size, std::memory_order_relaxed);
+    max_string_length_limit.store(limits.max_string_length, std::memory_order_relaxed);
+    max_elements_limit.store(limits.max_elements, std::memory_order_relaxed);
+}
+
+static std::atomic<utf8_mode> active_utf8_mode{ utf8_mode::STRICT };
+
+utf8_mode get_utf8_mode() { return active_utf8_mode.load(std::memory_order_relaxed); }
+
+void set_utf8_mode(utf8_mode mode) { active_utf8_mode.store(mode, std::memory_order_relaxed); }
+
+const char* to_string(parse_error error)
+{
+    switch (error) {
+    case parse_error::NONE:
+        return "no error";
+    case parse_error::UNEXPECTED_CHARACTER:
+        return "unexpected character";
+    case parse_error::UNEXPECTED_END:
+        return "unexpected end of input";
+    case parse_error::UNTERMINATED_STRING:
+        return "unterminated string";
+    case parse_error::BAD_ESCAPE:
+        return "invalid escape sequence";
+    case parse_error::INVALID_UTF8:
+        return "invalid UTF-8";
+    case parse_error::TRAILING_CONTENT:
+        return "content after the value";
+    case parse_error::STOPPED:
+        return "stopped by the handler";
+    case parse_error::FILE_ERROR:
+        return "the file could not be read";
+    case parse_error::DOCUMENT_TOO_LARGE:
+        return "document too large";
+    case parse_error::TOO_DEEP:
+        return "nesting too deep";
+    case parse_error::STRING_TOO_LONG:
+        return "string too long";
+    case parse_error::TOO_MANY_ELEMENTS:
+        return "too many elements";
+    case parse_error::INVALID_QUERY:
+        return "invalid query";
+    }
+    return "unknown error";
+}
+
+size_t parse_result::line() const
+{
+    locate();
+    return m_line;
+}
+
+size_t parse_result::column() const
+{
+    locate();
+    return m_column;
+}
+
+void parse_result::locate() const
+{
+    if (m_line != 0) {
+        return;
+    }
+    m_line = 1;
+    const char* line_start = m_input;
+    const char* end = m_input + (m_input ? offset : 0);
+    for (const char* p = m_input; p && p < end;) {
+        p = static_cast<const char*>(memchr(p, '\n', end - p));
+        if (p) {
+            ++m_line;
+            line_start = ++p;
+        }
+    }
+    m_column = m_input ? static_cast<size_t>(end - line_start) + 1 : 1;
+    m_input = nullptr;
+}
+
+namespace
+{
+/// the classification of a 64 bytes block. Bit `i` of each mask refers to the block's byte `i`
+struct block_masks {
+    uint64_t quote = 0;
+    uint64_t backslash = 0;
+    uint64_t structural = 0;
+    uint64_t whitespace = 0;
+};
+
+/// the state carried from one block to the next
+struct stage1_state {
+    /// all ones if the previous block ended inside a string
+    uint64_t prev_in_string = 0;
+    /// 1 if the first byte of the block is escaped by the previous block's last backslash
+    uint64_t prev_escaped = 0;
+    /// 1 if the previous block ended with a number / literal character
+    uint64_t prev_scalar = 0;
+};
+
+enum { C_QUOTE = 1, C_BACKSLASH = 2, C_STRUCTURAL = 4, C_WHITESPACE = 8 };
+
+struct char_class_table {
+    uint8_t table[256];
+    constexpr char_class_table()
+        : table()
+    {
+        // same definition of whitespace as `skip()`
+        for (int i = 1; i <= 32; ++i) {
+            table[i] = C_WHITESPACE;
+        }
+        table[static_cast<int>('"')] = C_QUOTE;
+        table[static_cast<int>('\\')] = C_BACKSLASH;
+        for (char c : { '{', '}', '[', ']', ':', ',' }) {
+            table[static_cast<int>(c)] = C_STRUCTURAL;
+        }
+    }
+};
+constexpr char_class_table char_classes;
+
+FLATTEN_INLINE uint64_t prefix_xor(uint64_t x)
+{
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+/// return the mask of the bytes escaped by a backslash. Backslashes are rare, so walking them one by one is
+/// cheaper (and simpler) than the branchless carry tricks
+FLATTEN_INLINE uint64_t find_escaped(uint64_t backslash, uint64_t& prev_escaped)
+{
+    uint64_t escaped = prev_escaped;
+    prev_escaped = 0;
+    backslash &= ~escaped;
+    while (backslash) {
+        int i = __builtin_ctzll(backslash);
+        if (i == 63) {
+            prev_escaped = 1;
+            break;
+        }
+        escaped |= 2ULL << i;
+        // an escaped backslash does not escape the next byte
+        backslash &= ~(3ULL << i);
+    }
+    return escaped;
+}
+
+/// combine the block's masks into the mask of its tokens
+FLATTEN_INLINE uint64_t block_tokens(stage1_state& state, const block_masks& masks)
+{
+    uint64_t quote = masks.quote & ~find_escaped(masks.backslash, state.prev_escaped);
+    // the opening quote is inside the string, the closing one is not
+    uint64_t in_string = prefix_xor(quote) ^ state.prev_in_string;
+    state.prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+    uint64_t scalar = ~(masks.structural | masks.whitespace | quote | in_string);
+    uint64_t scalar_start = scalar & ~((scalar << 1) | state.prev_scalar);
+    state.prev_scalar = scalar >> 63;
+    return (masks.structural & ~in_string) | quote | scalar_start;
+}
+
+/// append the offsets of the bits of `tokens` to the index
+FLATTEN_INLINE void write_tokens(std::vector<uint32_t>* index, size_t& count, uint32_t base, uint64_t tokens)
+{
+    size_t n = __builtin_popcountll(tokens);
+    if (count + n > index->size()) {
+        index->resize(std::max(index->size() * 2, count + 64));
+    }
+    uint32_t* out = index->data() + count;
+    while (tokens) {
+        *out++ = base + __builtin_ctzll(tokens);
+        tokens &= tokens - 1;
+    }
+    count += n;
+}
+
+FLATTEN_INLINE void classify_scalar(const char* block, block_masks& masks)
+{
+    for (int i = 0; i < 64; ++i) {
+        uint64_t bit = 1ULL << i;
+        switch (char_classes.table[static_cast<unsigned char>(block[i])]) {
+        case C_QUOTE:
+            masks.quote |= bit;
+            break;
+        case C_BACKSLASH:
+            masks.backslash |= bit;
+            break;
+        case C_STRUCTURAL:
+            masks.structural |= bit;
+            break;
+        case C_WHITESPACE:
+            masks.whitespace |= bit;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+#if TINYJSON_X86
+__attribute__((target("sse4.2"))) FLATTEN_INLINE void classify_sse42(const char* block, block_masks& masks)
+{
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lower = _mm_set1_epi8(0x20);
+    // `[` and `]` become `{` and `}` once 0x20 is or-ed
+    const __m128i open_brace = _mm_set1_epi8('{');
+    const __m128i close_brace = _mm_set1_epi8('}');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i zero = _mm_setzero_si128();
+    for (int i = 0; i < 4; ++i) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+        __m128i folded = _mm_or_si128(v, lower);
+        __m128i structural = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(folded, open_brace), _mm_cmpeq_epi8(folded, close_brace)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, colon), _mm_cmpeq_epi8(v, comma)));
+        // 0 < v <= 0x20
+        __m128i whitespace = _mm_andnot_si128(_mm_cmpeq_epi8(v, zero), _mm_cmpeq_epi8(_mm_min_epu8(v, lower), v));
+        int shift = i * 16;
+        masks.quote |= static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)) & 0xFFFF) << shift;
+        masks.backslash |= static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash)) & 0xFFFF)
+                           << shift;
+        masks.structural |= static_cast<uint64_t>(_mm_movemask_epi8(structural) & 0xFFFF) << shift;
+        masks.whitespace |= static_cast<uint64_t>(_mm_movemask_epi8(whitespace) & 0xFFFF) << shift;
+    }
+}
+
+__attribute__((target("avx2"))) FLATTEN_INLINE void classify_avx2(const char* block, block_masks& masks)
+{
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i lower = _mm256_set1_epi8(0x20);
+    const __m256i open_brace = _mm256_set1_epi8('{');
+    const __m256i close_brace = _mm256_set1_epi8('}');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i zero = _mm256_setzero_si256();
+    for (int i = 0; i < 2; ++i) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i * 32));
+        __m256i folded = _mm256_or_si256(v, lower);
+        __m256i structural = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(folded, open_brace), _mm256_cmpeq_epi8(folded, close_brace)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, colon), _mm256_cmpeq_epi8(v, comma)));
+        __m256i whitespace =
+            _mm256_andnot_si256(_mm256_cmpeq_epi8(v, zero), _mm256_cmpeq_epi8(_mm256_min_epu8(v, lower), v));
+        int shift = i * 32;
+        masks.quote |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, quote))))
+                       << shift;
+        masks.backslash |=
+            static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, backslash))))
+            << shift;
+        masks.structural |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(structural))) << shift;
+        masks.whitespace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(whitespace))) << shift;
+    }
+}
+#endif
+
+// The block loop is repeated for every kernel, so each copy is compiled for its own instruction set and the
+// classification is inlined into it
+#define TINYJSON_STAGE1_LOOP(CLASSIFY)                                       \
+    stage1_state state;                                                      \
+    size_t count = 0;                                                        \
+    size_t offset = 0;                                                       \
+    for (; offset + 64 <= len; offset += 64) {                               \
+        block_masks masks;                                                   \
+        CLASSIFY(data + offset, masks);                                      \
+        write_tokens(index, count, offset, block_tokens(state, masks));      \
+    }                                                                        \
+    if (offset < len) {                                                      \
+        /* pad the last block with whitespace */                             \
+        char block[64];                                                      \
+        memset(block, ' ', sizeof(block));                                   \
+        memcpy(block, data + offset, len - offset);                          \
+        block_masks masks;                                                   \
+        CLASSIFY(block, masks);                                              \
+        write_tokens(index, count, offset, block_tokens(state, masks));      \
+    }                                                                        \
+    index->resize(count);                                                    \
+    return state.prev_in_string == 0;
+
+bool stage1_scalar(const char* data, size_t len, std::vector<uint32_t>* index)
+{
+    TINYJSON_STAGE1_LOOP(classify_scalar)
+}
+
+#if TINYJSON_X86
+__attribute__((target("sse4.2"))) bool stage1_sse42(const char* data, size_t len, std::vector<uint32_t>* index)
+{
+    TINYJSON_STAGE1_LOOP(classify_sse42)
+}
+
+__attribute__((target("avx2"))) bool stage1_avx2(const char* data, size_t len, std::vector<uint32_t>* index)
+{
+    TINYJSON_STAGE1_LOOP(classify_avx2)
+}
+#endif
+#undef TINYJSON_STAGE1_LOOP
+
+/// inputs smaller than this are parsed without an index, building it does not pay off
+constexpr size_t STRUCTURAL_INDEX_MIN_SIZE = 4 * 1024;
+
+/// the largest index (in entries) a thread keeps for its next parses, see `release_structural_index`
+constexpr size_t STRUCTURAL_INDEX_MAX_RETAINED = 1024 * 1024;
+} // namespace
+
+bool build_structural_index(const char* data, size_t len, std::vector<uint32_t>* index)
+{
+    index->clear();
+    if (len >= UINT32_MAX) {
+        return false;
+    }
+
+    bool ok = false;
+    switch (get_simd_level()) {
+#if TINYJSON_X86
+    case simd_level::AVX2:
+        ok = stage1_avx2(data, len, index);
+        break;
+    case simd_level::SSE42:
+        ok = stage1_sse42(data, len, index);
+        break;
+#endif
+    default:
+        ok = stage1_scalar(data, len, index);
+        break;
+    }
+
+    // terminate the index with the input length, so the parser never runs past its end
+    index->push_back(static_cast<uint32_t>(len));
+    return ok;
+}
+
+/// the state of a single `parse` call
+struct parse_context {
+    /// the first byte of the input
+    const char* begin = nullptr;
+    /// one past the last byte of the input. The parser never reads beyond it
+    const char* end = nullptr;
+    /// when set, strings are unescaped inside the (mutable) input buffer and the elements point into it
+    bool insitu = false;
+    /// when set, the elements point to the raw strings inside the (read-only) input buffer.
+    /// Strings with escape sequences are decoded on first read
+    bool view = false;
+    /// the next entry of the structural index, nullptr when parsing without an index
+    const uint32_t* index = nullptr;
+    /// the limits in effect for this parse
+    parse_limits limits = get_parse_limits();
+    /// how invalid UTF-8 is handled
+    utf8_mode utf8 = get_utf8_mode();
+    /// set with `utf8_mode::REPLACE` once the input is known to hold invalid UTF-8: the strings are then checked
+    /// one by one and the invalid ones are passed to the handler as a copy, `repaired`
+    bool repair = false;
+    std::string repaired;
+    /// the values parsed so far, checked against `limits.max_elements`
+    size_t elements = 0;
+    /// why and where the parse failed. Only the first failure is kept
+    parse_error error = parse_error::NONE;
+    const char* failed_at = nullptr;
+
+    /// record why the parse failed at `at` and return nullptr, for the parse functions to return
+    const char* fail(parse_error reason, const char* at)
+    {
+        if (error == parse_error::NONE) {
+            error = reason;
+            failed_at = at;
+        }
+        return nullptr;
+    }
+
+    /// fail on the unexpected byte at `at`, which may be the end of the input
+    FLATTEN_INLINE const char* unexpected(const char* at)
+    {
+        return fail(at < end ? parse_error::UNEXPECTED_CHARACTER : parse_error::UNEXPECTED_END, at);
+    }
+
+    /// the outcome of the parse so far
+    FLATTEN_INLINE parse_result result() const
+    {
+        if (error == parse_error::NONE) {
+            return {};
+        }
+        return { error, static_cast<size_t>(failed_at - begin), begin };
+    }
+
+    /// true if `raw` is the string copied to `repaired`, which the handler can not keep a pointer to
+    FLATTEN_INLINE bool is_repaired(const char* raw) const { return repair && raw == repaired.data(); }
+
+    /// true if the input is larger than `limits.max_document_size`
+    FLATTEN_INLINE bool too_large() const { return static_cast<size_t>(end - begin) > limits.max_document_size; }
+
+    /// jump to the next token
+    FLATTEN_INLINE const char* skip(const char* in)
+    {
+        if (!index || !in) {
+            return tinyjson::skip(in, end);
+        }
+
+        uint32_t offset = static_cast<uint32_t>(in - begin);
+        while (*index < offset) {
+            ++index;
+        }
+
+        // `in` is either a token, whitespace followed by a token or a garbage byte glued to a number
+        // (e.g. `1x`), which must not be skipped
+        if (*index == offset || in == end || (unsigned char)*in > 32 || *in == 0) {
+            return in;
+        }
+        return begin + *index;
+    }
+
+    /// when `str` is an opening quote listed in the index, return its closing quote. nullptr otherwise
+    FLATTEN_INLINE const char* string_end(const char* str)
+    {
+        if (!index || begin + *index != str) {
+            return nullptr;
+        }
+        const char* closing = begin + index[1];
+        index += 2;
+        return closing < end ? closing : nullptr;
+    }
+};
+
+/// return true if `p` is before `end` and points to `c`
+FLATTEN_INLINE bool is_char(const char* p, const char* end, char c) { return p < end && *p == c; }
+
+namespace
+{
+/// the escape sequence of every byte: 0 for bytes that are copied as-is, 'u' for control characters written as
+/// `\u00XX`, the character following the backslash otherwise
+constexpr std::array<char, 256> make_escape_table()
+{
+    std::array<char, 256> table{};
+    for (int c = 0; c < 32; ++c) {
+        table[c] = 'u';
+    }
+    table['"'] = '"';
+    table['\\'] = '\\';
+    table['\b'] = 'b';
+    table['\f'] = 'f';
+    table['\n'] = 'n';
+    table['\r'] = 'r';
+    table['\t'] = 't';
+    return table;
+}
+constexpr std::array<char, 256> ESCAPE_TABLE = make_escape_table();
+
+/// the value of every hexadecimal digit, -1 for the other bytes
+constexpr std::array<int8_t, 256> make_hex_table()
+{
+    std::array<int8_t, 256> table{};
+    for (int c = 0; c < 256; ++c) {
+        table[c] = -1;
+    }
+    for (int c = 0; c < 10; ++c) {
+        table['0' + c] = static_cast<int8_t>(c);
+    }
+    for (int c = 0; c < 6; ++c) {
+        table['a' + c] = static_cast<int8_t>(10 + c);
+        table['A' + c] = static_cast<int8_t>(10 + c);
+    }
+    return table;
+}
+constexpr std::array<int8_t, 256> HEX_VALUES = make_hex_table();
+
+/// the value of the 4 hexadecimal digits at `p`, negative if one of them is not a digit
+FLATTEN_INLINE int32_t decode_hex4(const char* p)
+{
+    int32_t d0 = HEX_VALUES[(unsigned char)p[0]];
+    int32_t d1 = HEX_VALUES[(unsigned char)p[1]];
+    int32_t d2 = HEX_VALUES[(unsigned char)p[2]];
+    int32_t d3 = HEX_VALUES[(unsigned char)p[3]];
+    if ((d0 | d1 | d2 | d3) < 0) {
+        return -1;
+    }
+    return (d0 << 12) | (d1 << 8) | (d2 << 4) | d3;
+}
+
+/// return the first invalid escape sequence (its backslash) of the raw string [p, end), nullptr if they are all
+/// valid: a backslash is followed by one of `"\/bfnrt`, or by `u` and 4 hexadecimal digits. With
+/// `strict_surrogates`, a `\u` surrogate must also be a high surrogate directly followed by a low one
+const char* find_bad_escape(const char* p, const char* end, bool strict_surrogates)
+{
+    while ((p = static_cast<const char*>(memchr(p, '\\', end - p))) != nullptr) {
+        if (end - p < 2) {
+            return p;
+        }
+        switch (p[1]) {
+        case '"':
+        case '\\':
+        case '/':
+        case 'b':
+        case 'f':
+        case 'n':
+        case 'r':
+        case 't':
+            p += 2;
+            break;
+        case 'u': {
+            int32_t code = end - p < 6 ? -1 : decode_hex4(p + 2);
+            if (code < 0) {
+                return p;
+            }
+            if (strict_surrogates && code >= 0xD800 && code <= 0xDFFF) {
+                int32_t low = -1;
+                if (code <= 0xDBFF && end - p >= 12 && p[6] == '\\' && p[7] == 'u') {
+                    low = decode_hex4(p + 8);
+                }
+                if (low < 0xDC00 || low > 0xDFFF) {
+                    return p;
+                }
+                p += 6;
+            }
+            p += 6;
+            break;
+        }
+        default:
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+/// the length of the UTF-8 sequence starting with the non ASCII byte at `p` if it is valid. Otherwise minus the
+/// length of its longest valid prefix (at least 1 byte), which is replaced as a whole by U+FFFD
+int utf8_sequence(const unsigned char* p, const unsigned char* end)
+{
+    unsigned char c = p[0];
+    // the range of the second byte, which excludes the overlong forms, the surrogates and the code points above
+    // U+10FFFF. The other continuation bytes are 0x80..0xBF
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    int length = 0;
+    if (c >= 0xC2 && c <= 0xDF) {
+        length = 2;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        length = 3;
+        low = c == 0xE0 ? 0xA0 : 0x80;
+        high = c == 0xED ? 0x9F : 0xBF;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        length = 4;
+        low = c == 0xF0 ? 0x90 : 0x80;
+        high = c == 0xF4 ? 0x8F : 0xBF;
+    } else {
+        return -1;
+    }
+    for (int i = 1; i < length; ++i) {
+        if (p + i == end || p[i] < low || p[i] > high) {
+            return -i;
+        }
+        low = 0x80;
+        high = 0xBF;
+    }
+    return length;
+}
+
+/// return the first byte of the first invalid UTF-8 sequence in [p, end), nullptr if there is none
+const char* find_invalid_utf8_scalar(const char* p, const char* end)
+{
+    while (p < end) {
+        // 8 ASCII bytes at a time
+        if (end - p >= 8) {
+            uint64_t word;
+            memcpy(&word, p, sizeof(word));
+            if ((word & 0x8080808080808080ull) == 0) {
+                p += 8;
+                continue;
+            }
+        }
+        if ((unsigned char)*p < 0x80) {
+            ++p;
+            continue;
+        }
+        int length =
+            utf8_sequence(reinterpret_cast<const unsigned char*>(p), reinterpret_cast<const unsigned char*>(end));
+        if (length < 0) {
+            return p;
+        }
+        p += length;
+    }
+    return nullptr;
+}
+
+/// where the scalar check resumes for the block at `block`, when the vectorized check found an error in it or when
+/// the input ends: the first byte of the last sequence that started in the 3 bytes before it (the blocks before
+/// `block` are valid)
+FLATTEN_INLINE const char* utf8_resume_point(const char* data, const char* block)
+{
+    const char* p = block - std::min<size_t>(3, block - data);
+    while (p < block && ((unsigned char)*p & 0xC0) == 0x80) {
+        ++p;
+    }
+    return p;
+}
+
+#if TINYJSON_X86
+// The vectorized check of "Validating UTF-8 In Less Than One Instruction Per Byte" (Keiser and Lemire). Every
+// byte is checked against the byte before it with 3 lookups of 16 entries: the high and the low nibble of the
+// previous byte and the high nibble of the byte. Each table entry is the set of errors the nibble is compatible
+// with, so their intersection is not empty for an invalid pair. The 3rd and 4th bytes of the long sequences are
+// checked against the leading bytes 2 and 3 positions before them
+constexpr uint8_t UTF8_TOO_SHORT = 1 << 0;  // 11______ 0_______ or 11______ 11______
+constexpr uint8_t UTF8_TOO_LONG = 1 << 1;   // 0_______ 10______
+constexpr uint8_t UTF8_OVERLONG_3 = 1 << 2; // 11100000 100_____
+constexpr uint8_t UTF8_TOO_LARGE = 1 << 3;  // 11110100 1001____, 11110100 101_____, 11110101 10______ ...
+constexpr uint8_t UTF8_SURROGATE = 1 << 4;  // 11101101 101_____
+constexpr uint8_t UTF8_OVERLONG_2 = 1 << 5; // 1100000_ 10______
+constexpr uint8_t UTF8_TOO_LARGE_1000 = 1 << 6; // 11110101 1000____, 1111011_ 1000____, 11111___ 1000____
+constexpr uint8_t UTF8_OVERLONG_4 = 1 << 6;     // 11110000 1000____
+constexpr uint8_t UTF8_TWO_CONTINUATIONS = 1 << 7; // 10______ 10______
+constexpr uint8_t UTF8_CARRY = UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTINUATIONS;
+
+// the errors compatible with the high nibble of the previous byte
+alignas(16) constexpr uint8_t UTF8_PREV_HIGH[16] = {
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    UTF8_TOO_LONG, UTF8_TWO_CONTINUATIONS, UTF8_TWO_CONTINUATIONS, UTF8_TWO_CONTINUATIONS, UTF8_TWO_CONTINUATIONS,
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2, UTF8_TOO_SHORT, UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+    UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4
+};
+
+// the errors compatible with the low nibble of the previous byte
+alignas(16) constexpr uint8_t UTF8_PREV_LOW[16] = {
+    UTF8_CARRY | UTF8_OVERLONG_2 | UTF8_OVERLONG_3 | UTF8_OVERLONG_4,
+    UTF8_CARRY | UTF8_OVERLONG_2,
+    UTF8_CARRY,
+    UTF8_CARRY,
+    UTF8_CARRY | UTF8_TOO_LARGE,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000
+};
+
+// the errors compatible with the high nibble of the byte
+constexpr uint8_t UTF8_CONTINUATION_1000 = UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS |
+                                           UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4;
+constexpr uint8_t UTF8_CONTINUATION_1001 =
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE;
+constexpr uint8_t UTF8_CONTINUATION_101 =
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_SURROGATE | UTF8_TOO_LARGE;
+alignas(16) constexpr uint8_t UTF8_HIGH[16] = {
+    UTF8_TOO_SHORT,         UTF8_TOO_SHORT,         UTF8_TOO_SHORT,        UTF8_TOO_SHORT,
+    UTF8_TOO_SHORT,         UTF8_TOO_SHORT,         UTF8_TOO_SHORT,        UTF8_TOO_SHORT,
+    UTF8_CONTINUATION_1000, UTF8_CONTINUATION_1001, UTF8_CONTINUATION_101, UTF8_CONTINUATION_101,
+    UTF8_TOO_SHORT,         UTF8_TOO_SHORT,         UTF8_TOO_SHORT,        UTF8_TOO_SHORT
+};
+
+/// the bytes above which a sequence that starts in the last 3 bytes of a block continues in the next one
+alignas(32) constexpr uint8_t UTF8_INCOMPLETE[32] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                                      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                                      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF };
+
+__attribute__((target("sse4.2"))) const char* find_invalid_utf8_sse42(const char* data, const char* end)
+{
+    const __m128i prev_high_table = _mm_load_si128(reinterpret_cast<const __m128i*>(UTF8_PREV_HIGH));
+    const __m128i prev_low_table = _mm_load_si128(reinterpret_cast<const __m128i*>(UTF8_PREV_LOW));
+    const __m128i high_table = _mm_load_si128(reinterpret_cast<const __m128i*>(UTF8_HIGH));
+    const __m128i incomplete = _mm_loadu_si128(reinterpret_cast<const __m128i*>(UTF8_INCOMPLETE + 16));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i prev_input = _mm_setzero_si128();
+    __m128i prev_incomplete = _mm_setzero_si128();
+    const char* p = data;
+    for (; p + 16 <= end; p += 16) {
+        __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i error;
+        if (_mm_movemask_epi8(input) == 0) {
+            // ASCII only: the previous block must not end inside a sequence
+            error = prev_incomplete;
+        } else {
+            __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+            __m128i prev_high = _mm_shuffle_epi8(prev_high_table, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+            __m128i prev_low = _mm_shuffle_epi8(prev_low_table, _mm_and_si128(prev1, nibble));
+            __m128i high = _mm_shuffle_epi8(high_table, _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+            __m128i special = _mm_and_si128(_mm_and_si128(prev_high, prev_low), high);
+            // the bytes that must be the 3rd or the 4th byte of a sequence have their high bit set
+            __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+            __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+            __m128i must_continue = _mm_and_si128(_mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8(char(0xE0 - 0x80))),
+                                                               _mm_subs_epu8(prev3, _mm_set1_epi8(char(0xF0 - 0x80)))),
+                                                  _mm_set1_epi8(char(0x80)));
+            error = _mm_xor_si128(must_continue, special);
+            prev_incomplete = _mm_subs_epu8(input, incomplete);
+        }
+        if (!_mm_testz_si128(error, error)) {
+            return find_invalid_utf8_scalar(utf8_resume_point(data, p), end);
+        }
+        prev_input = input;
+    }
+    return find_invalid_utf8_scalar(utf8_resume_point(data, p), end);
+}
+
+__attribute__((target("avx2"))) const char* find_invalid_utf8_avx2(const char* data, const char* end)
+{
+    const __m256i prev_high_table =
+        _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(UTF8_PREV_HIGH)));
+    const __m256i prev_low_table =
+        _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(UTF8_PREV_LOW)));
+    const __m256i high_table = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(UTF8_HIGH)));
+    const __m256i incomplete = _mm256_load_si256(reinterpret_cast<const __m256i*>(UTF8_INCOMPLETE));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i prev_input = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+    const char* p = data;
+    for (; p + 32 <= end; p += 32) {
+        __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i error;
+        if (_mm256_movemask_epi8(input) == 0) {
+            error = prev_incomplete;
+        } else {
+            // the input shifted by 1, 2 and 3 bytes, the previous block's last bytes shifted in
+            __m256i carried = _mm256_permute2x128_si256(prev_input, input, 0x21);
+            __m256i prev1 = _mm256_alignr_epi8(input, carried, 15);
+            __m256i prev_high =
+                _mm256_shuffle_epi8(prev_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+            __m256i prev_low = _mm256_shuffle_epi8(prev_low_table, _mm256_and_si256(prev1, nibble));
+            __m256i high = _mm256_shuffle_epi8(high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+            __m256i special = _mm256_and_si256(_mm256_and_si256(prev_high, prev_low), high);
+            __m256i prev2 = _mm256_alignr_epi8(input, carried, 14);
+            __m256i prev3 = _mm256_alignr_epi8(input, carried, 13);
+            __m256i must_continue =
+                _mm256_and_si256(_mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xE0 - 0x80))),
+                                                 _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xF0 - 0x80)))),
+                                 _mm256_set1_epi8(char(0x80)));
+            error = _mm256_xor_si256(must_continue, special);
+            prev_incomplete = _mm256_subs_epu8(input, incomplete);
+        }
+        if (!_mm256_testz_si256(error, error)) {
+            return find_invalid_utf8_scalar(utf8_resume_point(data, p), end);
+        }
+        prev_input = input;
+    }
+    return find_invalid_utf8_scalar(utf8_resume_point(data, p), end);
+}
+#endif
+
+/// return the first byte of the first invalid UTF-8 sequence in [p, end), nullptr if there is none
+const char* find_invalid_utf8(const char* p, const char* end)
+{
+#if TINYJSON_X86
+    switch (get_simd_level()) {
+    case simd_level::AVX2:
+        return find_invalid_utf8_avx2(p, end);
+    case simd_level::SSE42:
+        return find_invalid_utf8_sse42(p, end);
+    default:
+        break;
+    }
+#endif
+    return find_invalid_utf8_scalar(p, end);
+}
+
+/// copy the raw string [p, end) to `out`, replacing every invalid UTF-8 sequence with U+FFFD
+void repair_utf8(const char* p, const char* end, std::string* out)
+{
+    out->clear();
+    const char* invalid;
+    while ((invalid = find_invalid_utf8(p, end)) != nullptr) {
+        out->append(p, invalid - p);
+        out->append("\xEF\xBF\xBD");
+        int length = utf8_sequence(reinterpret_cast<const unsigned char*>(invalid),
+                                   reinterpret_cast<const unsigned char*>(end));
+        p = invalid - length;
+    }
+    out->append(p, end - p);
+}
+
+/// return the first byte in [p, end) that must be escaped, `end` if there is none
+FLATTEN_INLINE const char* find_escape_scalar(const char* p, const char* end)
+{
+    while (p < end && ESCAPE_TABLE[(unsigned char)*p] == 0) {
+        ++p;
+    }
+    return p;
+}
+
+#if TINYJSON_X86
+__attribute__((target("sse4.2"))) const char* find_escape_sse42(const char* p, const char* end)
+{
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    for (; p + 16 <= end; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        // v <= 0x1F (unsigned), '"' or '\\'
+        __m128i escape = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(v, control), v),
+                                      _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)));
+        int mask = _mm_movemask_epi8(escape);
+        if (mask) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return find_escape_scalar(p, end);
+}
+
+__attribute__((target("avx2"))) const char* find_escape_avx2(const char* p, const char* end)
+{
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+    for (; p + 32 <= end; p += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i escape = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(v, control), v),
+                                         _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(escape));
+        if (mask) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return find_escape_sse42(p, end);
+}
+#endif
+
+using find_escape_func = const char* (*)(const char*, const char*);
+
+find_escape_func select_find_escape()
+{
+#if TINYJSON_X86
+    switch (get_simd_level()) {
+    case simd_level::AVX2:
+        return find_escape_avx2;
+    case simd_level::SSE42:
+        return find_escape_sse42;
+    default:
+        break;
+    }
+#endif
+    return [](const char* p, const char* end) { return find_escape_scalar(p, end); };
+}
+
+/// append `str` to `out` as a quoted JSON string. Runs of bytes that need no escaping are found with the
+/// active SIMD kernel and copied in one go, so a string with nothing to escape is a single scan and copy
+void append_escaped(std::string* out, const char* str, size_t len)
+{
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    const char* str_end = str + len;
+    find_escape_func find_escape = select_find_escape();
+    out->push_back('"');
+    while (str < str_end) {
+        const char* run = str;
+        str = find_escape(str, str_end);
+        out->append(run, str - run);
+        if (str == str_end) {
+            break;
+        }
+
+        unsigned char token = *str++;
+        char escape = ESCAPE_TABLE[token];
+        if (escape == 'u') {
+            char sequence[6] = { '\\', 'u', '0', '0', HEX_DIGITS[token >> 4], HEX_DIGITS[token & 0xF] };
+            out->append(sequence, sizeof(sequence));
+        } else {
+            char sequence[2] = { '\\', escape };
+            out->append(sequence, sizeof(sequence));
+        }
+    }
+    out->push_back('"');
+}
+} // namespace
+
+bool is_valid_utf8(const char* data, size_t len) { return find_invalid_utf8(data, data + len) == nullptr; }
+
+/// escape `in` to a printable version
+std::string& escape_string(const std::string_view& str, std::string* escaped)
+{
+    escaped->clear();
+    if (str.empty()) {
+        return *escaped;
+    }
+
+    // the string is not necessarily NULL terminated (e.g. a view into the parsed buffer)
+    append_escaped(escaped, str.data(), str.length());
+    return *escaped;
+}
+
+void append_json_string(std::string_view str, std::string* out) { append_escaped(out, str.data(), str.length()); }
+
+void append_json_number(double value, std::string* out)
+{
+    // JSON has no representation for NaN and the infinities
+    if (!std::isfinite(value)) {
+        out->append("null", 4);
+        return;
+    }
+
+    char buffer[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    // the shortest text that reads back as the same double, not affected by the locale
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out->append(buffer, result.ptr - buffer);
+#else
+    int len = snprintf(buffer, sizeof(buffer), "%.17g", value);
+    out->append(buffer, len);
+#endif
+}
+
+/// write the code point `code` as UTF-8 at `out`, return the byte after it
+FLATTEN_INLINE char* encode_utf8(uint32_t code, char* out)
+{
+    if (code < 0x80) {
+        *out++ = static_cast<char>(code);
+    } else if (code < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (code >> 6));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (code >> 12));
+        *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        *out++ = static_cast<char>(0xF0 | (code >> 18));
+        *out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    }
+    return out;
+}
+
+/// decode the JSON escape sequences of the raw string `str` (`len` bytes, without the quotes) into `out`.
+/// Decoding never grows the string, so `out` needs room for `len` bytes and it may even be `str` itself.
+/// An unpaired surrogate (or a `\u` with invalid digits) is decoded as U+FFFD, 3 bytes for the 6 of the escape.
+/// Return the decoded length
+size_t unescape_string(const char* str, size_t len, char* out)
+{
+    const char* ptr = str;
+    const char* end = str + len;
+    char* ptr2 = out;
+    TINYJSON_STAT(current_stats.unescaped_bytes += len);
+
+    while (ptr < end) {
+        // copy the run up to the next escape sequence
+        const char* backslash = static_cast<const char*>(memchr(ptr, '\\', end - ptr));
+        const char* run_end = backslash ? backslash : end;
+        if (ptr2 != ptr) {
+            memmove(ptr2, ptr, run_end - ptr);
+        }
+        ptr2 += run_end - ptr;
+        ptr = run_end;
+        if (ptr == end || ++ptr == end) {
+            break;
+        }
+        switch (*ptr) {
+        case 'b':
+            *ptr2++ = '\b';
+            break;
+        case 'f':
+            *ptr2++ = '\f';
+            break;
+        case 'n':
+            *ptr2++ = '\n';
+            break;
+        case 'r':
+            *ptr2++ = '\r';
+            break;
+        case 't':
+            *ptr2++ = '\t';
+            break;
+        case 'u': {
+            if (end - ptr < 5) {
+                ptr = end;
+                continue; // truncated sequence
+            }
+            // `\u0000` is kept as a NUL byte
+            int32_t code = decode_hex4(ptr + 1);
+            ptr += 4;
+            if (code >= 0xD800 && code <= 0xDBFF && end - ptr >= 7 && ptr[1] == '\\' && ptr[2] == 'u') {
+                int32_t low = decode_hex4(ptr + 3);
+                if (low >= 0xDC00 && low <= 0xDFFF) {
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    ptr += 6;
+                }
+            }
+            if (code < 0 || (code >= 0xD800 && code <= 0xDFFF)) {
+                code = 0xFFFD;
+            }
+            ptr2 = encode_utf8(static_cast<uint32_t>(code), ptr2);
+            break;
+        }
+        default:
+            *ptr2++ = *ptr;
+            break;
+        }
+        ptr++;
+    }
+    return ptr2 - out;
+}
+
+element::~element()
+{
+    m_key_index.clear();
+    m_children.clear();
+    release_strings();
+}
+
+element::element() { memset(&m_value, 0, sizeof(m_value)); }
+element::element(std::pmr::memory_resource* resource)
+    : m_children(resource)
+    , m_key_index(resource)
+{
+    memset(&m_value, 0, sizeof(m_value));
+}
+
+element::element(element&& other)
+    : m_kind(other.m_kind)
+    , m_flags(other.m_flags)
+    , m_str_len(other.m_str_len)
+    , m_property_name_len(other.m_property_name_len)
+    , m_property_name(other.m_property_name)
+    , m_value(other.m_value)
+    // move-construct (and not move-assign) the children so we keep the same memory resource
+    , m_children(std::move(other.m_children))
+    , m_key_index(std::move(other.m_key_index))
+{
+    // ensure that no double free is occured
+    other.m_property_name = nullptr;
+    if (other.m_kind == element_kind::T_STRING) {
+        other.m_value.str = nullptr;
+    }
+}
+
+char* element::new_string(const char* str, size_t len) const
+{
+    char* s = static_cast<char*>(resource()->allocate(len + 1, 1));
+    TINYJSON_STAT(count_allocation(len + 1));
+    memcpy(s, str, len);
+    s[len] = 0;
+    return s;
+}
+
+void element::release_strings()
+{
+    if (m_kind == element_kind::T_STRING) {
+        if (m_value.str && !(m_flags & F_BORROWED_STR)) {
+            resource()->deallocate(m_value.str, m_str_len + 1, 1);
+        }
+        m_value.str = nullptr;
+    }
+
+    if (m_property_name && !(m_flags & F_BORROWED_NAME)) {
+        resource()->deallocate(m_property_name, m_property_name_len + 1, 1);
+    }
+    m_property_name = nullptr;
+    m_flags = 0;
+}
+
+void element::set_property_name(const char* name, size_t len)
+{
+    if (m_property_name && !(m_flags & F_BORROWED_NAME)) {
+        resource()->deallocate(m_property_name, m_property_name_len + 1, 1);
+    }
+    m_property_name = nullptr;
+    m_flags &= ~F_BORROWED_NAME;
+
+    m_property_name_len = len;
+    if (len) {
+        m_property_name = new_string(name, len);
+    }
+}
+
+void element::set_int_value(int64_t value)
+{
+    m_kind = element_kind::T_INT64;
+    m_value.int64 = value;
+}
+
+void element::set_uint_value(uint64_t value)
+{
+    // keep the `T_UINT64` kind for the values that do not fit `T_INT64`
+    if (value <= static_cast<uint64_t>(INT64_MAX)) {
+        set_int_value(static_cast<int64_t>(value));
+        return;
+    }
+    m_kind = element_kind::T_UINT64;
+    m_value.uint64 = value;
+}
+
+void element::set_str_value(const char* str, size_t len)
+{
+    m_kind = element_kind::T_STRING;
+    m_flags &= ~F_BORROWED_STR;
+    m_str_len = len;
+    m_value.str = new_string(str, len);
+}
+
+void element::decode_str_value()
+{
+    // the raw string is borrowed from the parsed buffer, we only replace the pointer
+    thread_local std::string scratch;
+    scratch.resize(m_str_len);
+    size_t len = unescape_string(m_value.str, m_str_len, scratch.data());
+    m_flags &= ~(F_ESCAPED_STR | F_BORROWED_STR);
+    m_str_len = len;
+    m_value.str = new_string(scratch.data(), len);
+}
+
+void element::decode_property_name()
+{
+    size_t len = m_property_name_len;
+    const char* name = m_property_name;
+    thread_local std::string scratch;
+    if (m_flags & F_ESCAPED_NAME) {
+        scratch.resize(len);
+        len = unescape_string(m_property_name, len, scratch.data());
+        name = scratch.data();
+    }
+    m_flags &= ~(F_ESCAPED_NAME | F_UNTERMINATED_NAME | F_BORROWED_NAME);
+    m_property_name_len = len;
+    m_property_name = new_string(name, len);
+}
+
+// ----------------------------------------------------------------------------
+// Number conversion
+// ----------------------------------------------------------------------------
+//
+// A decimal `w * 10^q` is converted to the nearest double with (in order):
+// - Clinger's fast path: `w` and `10^q` are both exact doubles, so one IEEE multiplication / division rounds
+//   correctly
+// - Eisel-Lemire: `w` is multiplied by a 128 bit approximation of `5^q`, which is enough to round correctly
+//   any 19 digits mantissa
+// - `std::from_chars` on the original text, for the rare mantissas truncated at 19 digits where
+//   Eisel-Lemire can not decide between two doubles
+
+namespace
+{
+struct power_of_five {
+    uint64_t high;
+    uint64_t low;
+};
+
+constexpr int SMALLEST_POWER_OF_FIVE = -342;
+constexpr int LARGEST_POWER_OF_FIVE = 308;
+
+/// the 128 most significant bits of `5^q` for `q` in [-342, 308] (rounded up for `q` in [-27, -1])
+constexpr power_of_five POWERS_OF_FIVE[] = {
+    { 0xeef453d6923bd65a, 0x113faa2906a13b3f }, // 5^-342
+    { 0x9558b4661b6565f8, 0x4ac7ca59a424c507 }, // 5^-341
+    { 0xbaaee17fa23ebf76, 0x5d79bcf00d2df649 }, // 5^-340
+    { 0xe95a99df8ace6f53, 0xf4d82c2c107973dc }, // 5^-339
+    { 0x91d8a02bb6c10594, 0x79071b9b8a4be869 }, // 5^-338
+    { 0xb64ec836a47146f9, 0x9748e2826cdee284 }, // 5^-337
+    { 0xe3e27a444d8d98b7, 0xfd1b1b2308169b25 }, // 5^-336
+    { 0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7 }, // 5^-335
+    { 0xb208ef855c969f4f, 0xbdbd2d335e51a935 }, // 5^-334
+    { 0xde8b2b66b3bc4723, 0xad2c788035e61382 }, // 5^-333
+    { 0x8b16fb203055ac76, 0x4c3bcb5021afcc31 }, // 5^-332
+    { 0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d }, // 5^-331
+    { 0xd953e8624b85dd78, 0xd71d6dad34a2af0d }, // 5^-330
+    { 0x87d4713d6f33aa6b, 0x8672648c40e5ad68 }, // 5^-329
+    { 0xa9c98d8ccb009506, 0x680efdaf511f18c2 }, // 5^-328
+    { 0xd43bf0effdc0ba48, 0x0212bd1b2566def2 }, // 5^-327
+    { 0x84a57695fe98746d, 0x014bb630f7604b57 }, // 5^-326
+    { 0xa5ced43b7e3e9188, 0x419ea3bd35385e2d }, // 5^-325
+    { 0xcf42894a5dce35ea, 0x52064cac828675b9 }, // 5^-324
+    { 0x818995ce7aa0e1b2, 0x7343efebd1940993 }, // 5^-323
+    { 0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8 }, // 5^-322
+    { 0xca66fa129f9b60a6, 0xd41a26e077774ef6 }, // 5^-321
+    { 0xfd00b897478238d0, 0x8920b098955522b4 }, // 5^-320
+    { 0x9e20735e8cb16382, 0x55b46e5f5d5535b0 }, // 5^-319
+    { 0xc5a890362fddbc62, 0xeb2189f734aa831d }, // 5^-318
+    { 0xf712b443bbd52b7b, 0xa5e9ec7501d523e4 }, // 5^-317
+    { 0x9a6bb0aa55653b2d, 0x47b233c92125366e }, // 5^-316
+    { 0xc1069cd4eabe89f8, 0x999ec0bb696e840a }, // 5^-315
+    { 0xf148440a256e2c76, 0xc00670ea43ca250d }, // 5^-314
+    { 0x96cd2a865764dbca, 0x380406926a5e5728 }, // 5^-313
+    { 0xbc807527ed3e12bc, 0xc605083704f5ecf2 }, // 5^-312
+    { 0xeba09271e88d976b, 0xf7864a44c633682e }, // 5^-311
+    { 0x93445b8731587ea3, 0x7ab3ee6afbe0211d }, // 5^-310
+    { 0xb8157268fdae9e4c, 0x5960ea05bad82964 }, // 5^-309
+    { 0xe61acf033d1a45df, 0x6fb92487298e33bd }, // 5^-308
+    { 0x8fd0c16206306bab, 0xa5d3b6d479f8e056 }, // 5^-307
+    { 0xb3c4f1ba87bc8696, 0x8f48a4899877186c }, // 5^-306
+    { 0xe0b62e2929aba83c, 0x331acdabfe94de87 }, // 5^-305
+    { 0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14 }, // 5^-304
+    { 0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9 }, // 5^-303
+    { 0xdb71e91432b1a24a, 0xc9e82cd9f69d6150 }, // 5^-302
+    { 0x892731ac9faf056e, 0xbe311c083a225cd2 }, // 5^-301
+    { 0xab70fe17c79ac6ca, 0x6dbd630a48aaf406 }, // 5^-300
+    { 0xd64d3d9db981787d, 0x092cbbccdad5b108 }, // 5^-299
+    { 0x85f0468293f0eb4e, 0x25bbf56008c58ea5 }, // 5^-298
+    { 0xa76c582338ed2621, 0xaf2af2b80af6f24e }, // 5^-297
+    { 0xd1476e2c07286faa, 0x1af5af660db4aee1 }, // 5^-296
+    { 0x82cca4db847945ca, 0x50d98d9fc890ed4d }, // 5^-295
+    { 0xa37fce126597973c, 0xe50ff107bab528a0 }, // 5^-294
+    { 0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8 }, // 5^-293
+    { 0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a }, // 5^-292
+    { 0x9faacf3df73609b1, 0x77b191618c54e9ac }, // 5^-291
+    { 0xc795830d75038c1d, 0xd59df5b9ef6a2417 }, // 5^-290
+    { 0xf97ae3d0d2446f25, 0x4b0573286b44ad1d }, // 5^-289
+    { 0x9becce62836ac577, 0x4ee367f9430aec32 }, // 5^-288
+    { 0xc2e801fb244576d5, 0x229c41f793cda73f }, // 5^-287
+    { 0xf3a20279ed56d48a, 0x6b43527578c1110f }, // 5^-286
+    { 0x9845418c345644d6, 0x830a13896b78aaa9 }, // 5^-285
+    { 0xbe5691ef416bd60c, 0x23cc986bc656d553 }, // 5^-284
+    { 0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8 }, // 5^-283
+    { 0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9 }, // 5^-282
+    { 0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53 }, // 5^-281
+    { 0xe858ad248f5c22c9, 0xd1b3400f8f9cff68 }, // 5^-280
+    { 0x91376c36d99995be, 0x23100809b9c21fa1 }, // 5^-279
+    { 0xb58547448ffffb2d, 0xabd40a0c2832a78a }, // 5^-278
+    { 0xe2e69915b3fff9f9, 0x16c90c8f323f516c }, // 5^-277
+    { 0x8dd01fad907ffc3b, 0xae3da7d97f6792e3 }, // 5^-276
+    { 0xb1442798f49ffb4a, 0x99cd11cfdf41779c }, // 5^-275
+    { 0xdd95317f31c7fa1d, 0x40405643d711d583 }, // 5^-274
+    { 0x8a7d3eef7f1cfc52, 0x482835ea666b2572 }, // 5^-273
+    { 0xad1c8eab5ee43b66, 0xda3243650005eecf }, // 5^-272
+    { 0xd863b256369d4a40, 0x90bed43e40076a82 }, // 5^-271
+    { 0x873e4f75e2224e68, 0x5a7744a6e804a291 }, // 5^-270
+    { 0xa90de3535aaae202, 0x711515d0a205cb36 }, // 5^-269
+    { 0xd3515c2831559a83, 0x0d5a5b44ca873e03 }, // 5^-268
+    { 0x8412d9991ed58091, 0xe858790afe9486c2 }, // 5^-267
+    { 0xa5178fff668ae0b6, 0x626e974dbe39a872 }, // 5^-266
+    { 0xce5d73ff402d98e3, 0xfb0a3d212dc8128f }, // 5^-265
+    { 0x80fa687f881c7f8e, 0x7ce66634bc9d0b99 }, // 5^-264
+    { 0xa139029f6a239f72, 0x1c1fffc1ebc44e80 }, // 5^-263
+    { 0xc987434744ac874e, 0xa327ffb266b56220 }, // 5^-262
+    { 0xfbe9141915d7a922, 0x4bf1ff9f0062baa8 }, // 5^-261
+    { 0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9 }, // 5^-260
+    { 0xc4ce17b399107c22, 0xcb550fb4384d21d3 }, // 5^-259
+    { 0xf6019da07f549b2b, 0x7e2a53a146606a48 }, // 5^-258
+    { 0x99c102844f94e0fb, 0x2eda7444cbfc426d }, // 5^-257
+    { 0xc0314325637a1939, 0xfa911155fefb5308 }, // 5^-256
+    { 0xf03d93eebc589f88, 0x793555ab7eba27ca }, // 5^-255
+    { 0x96267c7535b763b5, 0x4bc1558b2f3458de }, // 5^-254
+    { 0xbbb01b9283253ca2, 0x9eb1aaedfb016f16 }, // 5^-253
+    { 0xea9c227723ee8bcb, 0x465e15a979c1cadc }, // 5^-252
+    { 0x92a1958a7675175f, 0x0bfacd89ec191ec9 }, // 5^-251
+    { 0xb749faed14125d36, 0xcef980ec671f667b }, // 5^-250
+    { 0xe51c79a85916f484, 0x82b7e12780e7401a }, // 5^-249
+    { 0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810 }, // 5^-248
+    { 0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15 }, // 5^-247
+    { 0xdfbdcece67006ac9, 0x67a791e093e1d49a }, // 5^-246
+    { 0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0 }, // 5^-245
+    { 0xaecc49914078536d, 0x58fae9f773886e18 }, // 5^-244
+    { 0xda7f5bf590966848, 0xaf39a475506a899e }, // 5^-243
+    { 0x888f99797a5e012d, 0x6d8406c952429603 }, // 5^-242
+    { 0xaab37fd7d8f58178, 0xc8e5087ba6d33b83 }, // 5^-241
+    { 0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64 }, // 5^-240
+    { 0x855c3be0a17fcd26, 0x5cf2eea09a55067f }, // 5^-239
+    { 0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e }, // 5^-238
+    { 0xd0601d8efc57b08b, 0xf13b94daf124da26 }, // 5^-237
+    { 0x823c12795db6ce57, 0x76c53d08d6b70858 }, // 5^-236
+    { 0xa2cb1717b52481ed, 0x54768c4b0c64ca6e }, // 5^-235
+    { 0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09 }, // 5^-234
+    { 0xfe5d54150b090b02, 0xd3f93b35435d7c4c }, // 5^-233
+    { 0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf }, // 5^-232
+    { 0xc6b8e9b0709f109a, 0x359ab6419ca1091b }, // 5^-231
+    { 0xf867241c8cc6d4c0, 0xc30163d203c94b62 }, // 5^-230
+    { 0x9b407691d7fc44f8, 0x79e0de63425dcf1d }, // 5^-229
+    { 0xc21094364dfb5636, 0x985915fc12f542e4 }, // 5^-228
+    { 0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d }, // 5^-227
+    { 0x979cf3ca6cec5b5a, 0xa705992ceecf9c42 }, // 5^-226
+    { 0xbd8430bd08277231, 0x50c6ff782a838353 }, // 5^-225
+    { 0xece53cec4a314ebd, 0xa4f8bf5635246428 }, // 5^-224
+    { 0x940f4613ae5ed136, 0x871b7795e136be99 }, // 5^-223
+    { 0xb913179899f68584, 0x28e2557b59846e3f }, // 5^-222
+    { 0xe757dd7ec07426e5, 0x331aeada2fe589cf }, // 5^-221
+    { 0x9096ea6f3848984f, 0x3ff0d2c85def7621 }, // 5^-220
+    { 0xb4bca50b065abe63, 0x0fed077a756b53a9 }, // 5^-219
+    { 0xe1ebce4dc7f16dfb, 0xd3e8495912c62894 }, // 5^-218
+    { 0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c }, // 5^-217
+    { 0xb080392cc4349dec, 0xbd8d794d96aacfb3 }, // 5^-216
+    { 0xdca04777f541c567, 0xecf0d7a0fc5583a0 }, // 5^-215
+    { 0x89e42caaf9491b60, 0xf41686c49db57244 }, // 5^-214
+    { 0xac5d37d5b79b6239, 0x311c2875c522ced5 }, // 5^-213
+    { 0xd77485cb25823ac7, 0x7d633293366b828b }, // 5^-212
+    { 0x86a8d39ef77164bc, 0xae5dff9c02033197 }, // 5^-211
+    { 0xa8530886b54dbdeb, 0xd9f57f830283fdfc }, // 5^-210
+    { 0xd267caa862a12d66, 0xd072df63c324fd7b }, // 5^-209
+    { 0x8380dea93da4bc60, 0x4247cb9e59f71e6d }, // 5^-208
+    { 0xa46116538d0deb78, 0x52d9be85f074e608 }, // 5^-207
+    { 0xcd795be870516656, 0x67902e276c921f8b }, // 5^-206
+    { 0x806bd9714632dff6, 0x00ba1cd8a3db53b6 }, // 5^-205
+    { 0xa086cfcd97bf97f3, 0x80e8a40eccd228a4 }, // 5^-204
+    { 0xc8a883c0fdaf7df0, 0x6122cd128006b2cd }, // 5^-203
+    { 0xfad2a4b13d1b5d6c, 0x796b805720085f81 }, // 5^-202
+    { 0x9cc3a6eec6311a63, 0xcbe3303674053bb0 }, // 5^-201
+    { 0xc3f490aa77bd60fc, 0xbedbfc4411068a9c }, // 5^-200
+    { 0xf4f1b4d515acb93b, 0xee92fb5515482d44 }, // 5^-199
+    { 0x991711052d8bf3c5, 0x751bdd152d4d1c4a }, // 5^-198
+    { 0xbf5cd54678eef0b6, 0xd262d45a78a0635d }, // 5^-197
+    { 0xef340a98172aace4, 0x86fb897116c87c34 }, // 5^-196
+    { 0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0 }, // 5^-195
+    { 0xbae0a846d2195712, 0x8974836059cca109 }, // 5^-194
+    { 0xe998d258869facd7, 0x2bd1a438703fc94b }, // 5^-193
+    { 0x91ff83775423cc06, 0x7b6306a34627ddcf }, // 5^-192
+    { 0xb67f6455292cbf08, 0x1a3bc84c17b1d542 }, // 5^-191
+    { 0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93 }, // 5^-190
+    { 0x8e938662882af53e, 0x547eb47b7282ee9c }, // 5^-189
+    { 0xb23867fb2a35b28d, 0xe99e619a4f23aa43 }, // 5^-188
+    { 0xdec681f9f4c31f31, 0x6405fa00e2ec94d4 }, // 5^-187
+    { 0x8b3c113c38f9f37e, 0xde83bc408dd3dd04 }, // 5^-186
+    { 0xae0b158b4738705e, 0x9624ab50b148d445 }, // 5^-185
+    { 0xd98ddaee19068c76, 0x3badd624dd9b0957 }, // 5^-184
+    { 0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6 }, // 5^-183
+    { 0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c }, // 5^-182
+    { 0xd47487cc8470652b, 0x7647c3200069671f }, // 5^-181
+    { 0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073 }, // 5^-180
+    { 0xa5fb0a17c777cf09, 0xf468107100525890 }, // 5^-179
+    { 0xcf79cc9db955c2cc, 0x7182148d4066eeb4 }, // 5^-178
+    { 0x81ac1fe293d599bf, 0xc6f14cd848405530 }, // 5^-177
+    { 0xa21727db38cb002f, 0xb8ada00e5a506a7c }, // 5^-176
+    { 0xca9cf1d206fdc03b, 0xa6d90811f0e4851c }, // 5^-175
+    { 0xfd442e4688bd304a, 0x908f4a166d1da663 }, // 5^-174
+    { 0x9e4a9cec15763e2e, 0x9a598e4e043287fe }, // 5^-173
+    { 0xc5dd44271ad3cdba, 0x40eff1e1853f29fd }, // 5^-172
+    { 0xf7549530e188c128, 0xd12bee59e68ef47c }, // 5^-171
+    { 0x9a94dd3e8cf578b9, 0x82bb74f8301958ce }, // 5^-170
+    { 0xc13a148e3032d6e7, 0xe36a52363c1faf01 }, // 5^-169
+    { 0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1 }, // 5^-168
+    { 0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9 }, // 5^-167
+    { 0xbcb2b812db11a5de, 0x7415d448f6b6f0e7 }, // 5^-166
+    { 0xebdf661791d60f56, 0x111b495b3464ad21 }, // 5^-165
+    { 0x936b9fcebb25c995, 0xcab10dd900beec34 }, // 5^-164
+    { 0xb84687c269ef3bfb, 0x3d5d514f40eea742 }, // 5^-163
+    { 0xe65829b3046b0afa, 0x0cb4a5a3112a5112 }, // 5^-162
+    { 0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab }, // 5^-161
+    { 0xb3f4e093db73a093, 0x59ed216765690f56 }, // 5^-160
+    { 0xe0f218b8d25088b8, 0x306869c13ec3532c }, // 5^-159
+    { 0x8c974f7383725573, 0x1e414218c73a13fb }, // 5^-158
+    { 0xafbd2350644eeacf, 0xe5d1929ef90898fa }, // 5^-157
+    { 0xdbac6c247d62a583, 0xdf45f746b74abf39 }, // 5^-156
+    { 0x894bc396ce5da772, 0x6b8bba8c328eb783 }, // 5^-155
+    { 0xab9eb47c81f5114f, 0x066ea92f3f326564 }, // 5^-154
+    { 0xd686619ba27255a2, 0xc80a537b0efefebd }, // 5^-153
+    { 0x8613fd0145877585, 0xbd06742ce95f5f36 }, // 5^-152
+    { 0xa798fc4196e952e7, 0x2c48113823b73704 }, // 5^-151
+    { 0xd17f3b51fca3a7a0, 0xf75a15862ca504c5 }, // 5^-150
+    { 0x82ef85133de648c4, 0x9a984d73dbe722fb }, // 5^-149
+    { 0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba }, // 5^-148
+    { 0xcc963fee10b7d1b3, 0x318df905079926a8 }, // 5^-147
+    { 0xffbbcfe994e5c61f, 0xfdf17746497f7052 }, // 5^-146
+    { 0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633 }, // 5^-145
+    { 0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0 }, // 5^-144
+    { 0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0 }, // 5^-143
+    { 0x9c1661a651213e2d, 0x06bea10ca65c084e }, // 5^-142
+    { 0xc31bfa0fe5698db8, 0x486e494fcff30a62 }, // 5^-141
+    { 0xf3e2f893dec3f126, 0x5a89dba3c3efccfa }, // 5^-140
+    { 0x986ddb5c6b3a76b7, 0xf89629465a75e01c }, // 5^-139
+    { 0xbe89523386091465, 0xf6bbb397f1135823 }, // 5^-138
+    { 0xee2ba6c0678b597f, 0x746aa07ded582e2c }, // 5^-137
+    { 0x94db483840b717ef, 0xa8c2a44eb4571cdc }, // 5^-136
+    { 0xba121a4650e4ddeb, 0x92f34d62616ce413 }, // 5^-135
+    { 0xe896a0d7e51e1566, 0x77b020baf9c81d17 }, // 5^-134
+    { 0x915e2486ef32cd60, 0x0ace1474dc1d122e }, // 5^-133
+    { 0xb5b5ada8aaff80b8, 0x0d819992132456ba }, // 5^-132
+    { 0xe3231912d5bf60e6, 0x10e1fff697ed6c69 }, // 5^-131
+    { 0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1 }, // 5^-130
+    { 0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2 }, // 5^-129
+    { 0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde }, // 5^-128
+    { 0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b }, // 5^-127
+    { 0xad4ab7112eb3929d, 0x86c16c98d2c953c6 }, // 5^-126
+    { 0xd89d64d57a607744, 0xe871c7bf077ba8b7 }, // 5^-125
+    { 0x87625f056c7c4a8b, 0x11471cd764ad4972 }, // 5^-124
+    { 0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf }, // 5^-123
+    { 0xd389b47879823479, 0x4aff1d108d4ec2c3 }, // 5^-122
+    { 0x843610cb4bf160cb, 0xcedf722a585139ba }, // 5^-121
+    { 0xa54394fe1eedb8fe, 0xc2974eb4ee658828 }, // 5^-120
+    { 0xce947a3da6a9273e, 0x733d226229feea32 }, // 5^-119
+    { 0x811ccc668829b887, 0x0806357d5a3f525f }, // 5^-118
+    { 0xa163ff802a3426a8, 0xca07c2dcb0cf26f7 }, // 5^-117
+    { 0xc9bcff6034c13052, 0xfc89b393dd02f0b5 }, // 5^-116
+    { 0xfc2c3f3841f17c67, 0xbbac2078d443ace2 }, // 5^-115
+    { 0x9d9ba7832936edc0, 0xd54b944b84aa4c0d }, // 5^-114
+    { 0xc5029163f384a931, 0x0a9e795e65d4df11 }, // 5^-113
+    { 0xf64335bcf065d37d, 0x4d4617b5ff4a16d5 }, // 5^-112
+    { 0x99ea0196163fa42e, 0x504bced1bf8e4e45 }, // 5^-111
+    { 0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6 }, // 5^-110
+    { 0xf07da27a82c37088, 0x5d767327bb4e5a4c }, // 5^-109
+    { 0x964e858c91ba2655, 0x3a6a07f8d510f86f }, // 5^-108
+    { 0xbbe226efb628afea, 0x890489f70a55368b }, // 5^-107
+    { 0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e }, // 5^-106
+    { 0x92c8ae6b464fc96f, 0x3b0b8bc90012929d }, // 5^-105
+    { 0xb77ada0617e3bbcb, 0x09ce6ebb40173744 }, // 5^-104
+    { 0xe55990879ddcaabd, 0xcc420a6a101d0515 }, // 5^-103
+    { 0x8f57fa54c2a9eab6, 0x9fa946824a12232d }, // 5^-102
+    { 0xb32df8e9f3546564, 0x47939822dc96abf9 }, // 5^-101
+    { 0xdff9772470297ebd, 0x59787e2b93bc56f7 }, // 5^-100
+    { 0x8bfbea76c619ef36, 0x57eb4edb3c55b65a }, // 5^-99
+    { 0xaefae51477a06b03, 0xede622920b6b23f1 }, // 5^-98
+    { 0xdab99e59958885c4, 0xe95fab368e45eced }, // 5^-97
+    { 0x88b402f7fd75539b, 0x11dbcb0218ebb414 }, // 5^-96
+    { 0xaae103b5fcd2a881, 0xd652bdc29f26a119 }, // 5^-95
+    { 0xd59944a37c0752a2, 0x4be76d3346f0495f }, // 5^-94
+    { 0x857fcae62d8493a5, 0x6f70a4400c562ddb }, // 5^-93
+    { 0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952 }, // 5^-92
+    { 0xd097ad07a71f26b2, 0x7e2000a41346a7a7 }, // 5^-91
+    { 0x825ecc24c873782f, 0x8ed400668c0c28c8 }, // 5^-90
+    { 0xa2f67f2dfa90563b, 0x728900802f0f32fa }, // 5^-89
+    { 0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9 }, // 5^-88
+    { 0xfea126b7d78186bc, 0xe2f610c84987bfa8 }, // 5^-87
+    { 0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9 }, // 5^-86
+    { 0xc6ede63fa05d3143, 0x91503d1c79720dbb }, // 5^-85
+    { 0xf8a95fcf88747d94, 0x75a44c6397ce912a }, // 5^-84
+    { 0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba }, // 5^-83
+    { 0xc24452da229b021b, 0xfbe85badce996168 }, // 5^-82
+    { 0xf2d56790ab41c2a2, 0xfae27299423fb9c3 }, // 5^-81
+    { 0x97c560ba6b0919a5, 0xdccd879fc967d41a }, // 5^-80
+    { 0xbdb6b8e905cb600f, 0x5400e987bbc1c920 }, // 5^-79
+    { 0xed246723473e3813, 0x290123e9aab23b68 }, // 5^-78
+    { 0x9436c0760c86e30b, 0xf9a0b6720aaf6521 }, // 5^-77
+    { 0xb94470938fa89bce, 0xf808e40e8d5b3e69 }, // 5^-76
+    { 0xe7958cb87392c2c2, 0xb60b1d1230b20e04 }, // 5^-75
+    { 0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2 }, // 5^-74
+    { 0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3 }, // 5^-73
+    { 0xe2280b6c20dd5232, 0x25c6da63c38de1b0 }, // 5^-72
+    { 0x8d590723948a535f, 0x579c487e5a38ad0e }, // 5^-71
+    { 0xb0af48ec79ace837, 0x2d835a9df0c6d851 }, // 5^-70
+    { 0xdcdb1b2798182244, 0xf8e431456cf88e65 }, // 5^-69
+    { 0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff }, // 5^-68
+    { 0xac8b2d36eed2dac5, 0xe272467e3d222f3f }, // 5^-67
+    { 0xd7adf884aa879177, 0x5b0ed81dcc6abb0f }, // 5^-66
+    { 0x86ccbb52ea94baea, 0x98e947129fc2b4e9 }, // 5^-65
+    { 0xa87fea27a539e9a5, 0x3f2398d747b36224 }, // 5^-64
+    { 0xd29fe4b18e88640e, 0x8eec7f0d19a03aad }, // 5^-63
+    { 0x83a3eeeef9153e89, 0x1953cf68300424ac }, // 5^-62
+    { 0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7 }, // 5^-61
+    { 0xcdb02555653131b6, 0x3792f412cb06794d }, // 5^-60
+    { 0x808e17555f3ebf11, 0xe2bbd88bbee40bd0 }, // 5^-59
+    { 0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4 }, // 5^-58
+    { 0xc8de047564d20a8b, 0xf245825a5a445275 }, // 5^-57
+    { 0xfb158592be068d2e, 0xeed6e2f0f0d56712 }, // 5^-56
+    { 0x9ced737bb6c4183d, 0x55464dd69685606b }, // 5^-55
+    { 0xc428d05aa4751e4c, 0xaa97e14c3c26b886 }, // 5^-54
+    { 0xf53304714d9265df, 0xd53dd99f4b3066a8 }, // 5^-53
+    { 0x993fe2c6d07b7fab, 0xe546a8038efe4029 }, // 5^-52
+    { 0xbf8fdb78849a5f96, 0xde98520472bdd033 }, // 5^-51
+    { 0xef73d256a5c0f77c, 0x963e66858f6d4440 }, // 5^-50
+    { 0x95a8637627989aad, 0xdde7001379a44aa8 }, // 5^-49
+    { 0xbb127c53b17ec159, 0x5560c018580d5d52 }, // 5^-48
+    { 0xe9d71b689dde71af, 0xaab8f01e6e10b4a6 }, // 5^-47
+    { 0x9226712162ab070d, 0xcab3961304ca70e8 }, // 5^-46
+    { 0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22 }, // 5^-45
+    { 0xe45c10c42a2b3b05, 0x8cb89a7db77c506a }, // 5^-44
+    { 0x8eb98a7a9a5b04e3, 0x77f3608e92adb242 }, // 5^-43
+    { 0xb267ed1940f1c61c, 0x55f038b237591ed3 }, // 5^-42
+    { 0xdf01e85f912e37a3, 0x6b6c46dec52f6688 }, // 5^-41
+    { 0x8b61313bbabce2c6, 0x2323ac4b3b3da015 }, // 5^-40
+    { 0xae397d8aa96c1b77, 0xabec975e0a0d081a }, // 5^-39
+    { 0xd9c7dced53c72255, 0x96e7bd358c904a21 }, // 5^-38
+    { 0x881cea14545c7575, 0x7e50d64177da2e54 }, // 5^-37
+    { 0xaa242499697392d2, 0xdde50bd1d5d0b9e9 }, // 5^-36
+    { 0xd4ad2dbfc3d07787, 0x955e4ec64b44e864 }, // 5^-35
+    { 0x84ec3c97da624ab4, 0xbd5af13bef0b113e }, // 5^-34
+    { 0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e }, // 5^-33
+    { 0xcfb11ead453994ba, 0x67de18eda5814af2 }, // 5^-32
+    { 0x81ceb32c4b43fcf4, 0x80eacf948770ced7 }, // 5^-31
+    { 0xa2425ff75e14fc31, 0xa1258379a94d028d }, // 5^-30
+    { 0xcad2f7f5359a3b3e, 0x096ee45813a04330 }, // 5^-29
+    { 0xfd87b5f28300ca0d, 0x8bca9d6e188853fc }, // 5^-28
+    { 0x9e74d1b791e07e48, 0x775ea264cf55347e }, // 5^-27
+    { 0xc612062576589dda, 0x95364afe032a819e }, // 5^-26
+    { 0xf79687aed3eec551, 0x3a83ddbd83f52205 }, // 5^-25
+    { 0x9abe14cd44753b52, 0xc4926a9672793543 }, // 5^-24
+    { 0xc16d9a0095928a27, 0x75b7053c0f178294 }, // 5^-23
+    { 0xf1c90080baf72cb1, 0x5324c68b12dd6339 }, // 5^-22
+    { 0x971da05074da7bee, 0xd3f6fc16ebca5e04 }, // 5^-21
+    { 0xbce5086492111aea, 0x88f4bb1ca6bcf585 }, // 5^-20
+    { 0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6 }, // 5^-19
+    { 0x9392ee8e921d5d07, 0x3aff322e62439fd0 }, // 5^-18
+    { 0xb877aa3236a4b449, 0x09befeb9fad487c3 }, // 5^-17
+    { 0xe69594bec44de15b, 0x4c2ebe687989a9b4 }, // 5^-16
+    { 0x901d7cf73ab0acd9, 0x0f9d37014bf60a11 }, // 5^-15
+    { 0xb424dc35095cd80f, 0x538484c19ef38c95 }, // 5^-14
+    { 0xe12e13424bb40e13, 0x2865a5f206b06fba }, // 5^-13
+    { 0x8cbccc096f5088cb, 0xf93f87b7442e45d4 }, // 5^-12
+    { 0xafebff0bcb24aafe, 0xf78f69a51539d749 }, // 5^-11
+    { 0xdbe6fecebdedd5be, 0xb573440e5a884d1c }, // 5^-10
+    { 0x89705f4136b4a597, 0x31680a88f8953031 }, // 5^-9
+    { 0xabcc77118461cefc, 0xfdc20d2b36ba7c3e }, // 5^-8
+    { 0xd6bf94d5e57a42bc, 0x3d32907604691b4d }, // 5^-7
+    { 0x8637bd05af6c69b5, 0xa63f9a49c2c1b110 }, // 5^-6
+    { 0xa7c5ac471b478423, 0x0fcf80dc33721d54 }, // 5^-5
+    { 0xd1b71758e219652b, 0xd3c36113404ea4a9 }, // 5^-4
+    { 0x83126e978d4fdf3b, 0x645a1cac083126ea }, // 5^-3
+    { 0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4 }, // 5^-2
+    { 0xcccccccccccccccc, 0xcccccccccccccccd }, // 5^-1
+    { 0x8000000000000000, 0x0000000000000000 }, // 5^0
+    { 0xa000000000000000, 0x0000000000000000 }, // 5^1
+    { 0xc800000000000000, 0x0000000000000000 }, // 5^2
+    { 0xfa00000000000000, 0x0000000000000000 }, // 5^3
+    { 0x9c40000000000000, 0x0000000000000000 }, // 5^4
+    { 0xc350000000000000, 0x0000000000000000 }, // 5^5
+    { 0xf424000000000000, 0x0000000000000000 }, // 5^6
+    { 0x9896800000000000, 0x0000000000000000 }, // 5^7
+    { 0xbebc200000000000, 0x0000000000000000 }, // 5^8
+    { 0xee6b280000000000, 0x0000000000000000 }, // 5^9
+    { 0x9502f90000000000, 0x0000000000000000 }, // 5^10
+    { 0xba43b74000000000, 0x0000000000000000 }, // 5^11
+    { 0xe8d4a51000000000, 0x0000000000000000 }, // 5^12
+    { 0x9184e72a00000000, 0x0000000000000000 }, // 5^13
+    { 0xb5e620f480000000, 0x0000000000000000 }, // 5^14
+    { 0xe35fa931a0000000, 0x0000000000000000 }, // 5^15
+    { 0x8e1bc9bf04000000, 0x0000000000000000 }, // 5^16
+    { 0xb1a2bc2ec5000000, 0x0000000000000000 }, // 5^17
+    { 0xde0b6b3a76400000, 0x0000000000000000 }, // 5^18
+    { 0x8ac7230489e80000, 0x0000000000000000 }, // 5^19
+    { 0xad78ebc5ac620000, 0x0000000000000000 }, // 5^20
+    { 0xd8d726b7177a8000, 0x0000000000000000 }, // 5^21
+    { 0x878678326eac9000, 0x0000000000000000 }, // 5^22
+    { 0xa968163f0a57b400, 0x0000000000000000 }, // 5^23
+    { 0xd3c21bcecceda100, 0x0000000000000000 }, // 5^24
+    { 0x84595161401484a0, 0x0000000000000000 }, // 5^25
+    { 0xa56fa5b99019a5c8, 0x0000000000000000 }, // 5^26
+    { 0xcecb8f27f4200f3a, 0x0000000000000000 }, // 5^27
+    { 0x813f3978f8940984, 0x4000000000000000 }, // 5^28
+    { 0xa18f07d736b90be5, 0x5000000000000000 }, // 5^29
+    { 0xc9f2c9cd04674ede, 0xa400000000000000 }, // 5^30
+    { 0xfc6f7c4045812296, 0x4d00000000000000 }, // 5^31
+    { 0x9dc5ada82b70b59d, 0xf020000000000000 }, // 5^32
+    { 0xc5371912364ce305, 0x6c28000000000000 }, // 5^33
+    { 0xf684df56c3e01bc6, 0xc732000000000000 }, // 5^34
+    { 0x9a130b963a6c115c, 0x3c7f400000000000 }, // 5^35
+    { 0xc097ce7bc90715b3, 0x4b9f100000000000 }, // 5^36
+    { 0xf0bdc21abb48db20, 0x1e86d40000000000 }, // 5^37
+    { 0x96769950b50d88f4, 0x1314448000000000 }, // 5^38
+    { 0xbc143fa4e250eb31, 0x17d955a000000000 }, // 5^39
+    { 0xeb194f8e1ae525fd, 0x5dcfab0800000000 }, // 5^40
+    { 0x92efd1b8d0cf37be, 0x5aa1cae500000000 }, // 5^41
+    { 0xb7abc627050305ad, 0xf14a3d9e40000000 }, // 5^42
+    { 0xe596b7b0c643c719, 0x6d9ccd05d0000000 }, // 5^43
+    { 0x8f7e32ce7bea5c6f, 0xe4820023a2000000 }, // 5^44
+    { 0xb35dbf821ae4f38b, 0xdda2802c8a800000 }, // 5^45
+    { 0xe0352f62a19e306e, 0xd50b2037ad200000 }, // 5^46
+    { 0x8c213d9da502de45, 0x4526f422cc340000 }, // 5^47
+    { 0xaf298d050e4395d6, 0x9670b12b7f410000 }, // 5^48
+    { 0xdaf3f04651d47b4c, 0x3c0cdd765f114000 }, // 5^49
+    { 0x88d8762bf324cd0f, 0xa5880a69fb6ac800 }, // 5^50
+    { 0xab0e93b6efee0053, 0x8eea0d047a457a00 }, // 5^51
+    { 0xd5d238a4abe98068, 0x72a4904598d6d880 }, // 5^52
+    { 0x85a36366eb71f041, 0x47a6da2b7f864750 }, // 5^53
+    { 0xa70c3c40a64e6c51, 0x999090b65f67d924 }, // 5^54
+    { 0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d }, // 5^55
+    { 0x82818f1281ed449f, 0xbff8f10e7a8921a4 }, // 5^56
+    { 0xa321f2d7226895c7, 0xaff72d52192b6a0d }, // 5^57
+    { 0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490 }, // 5^58
+    { 0xfee50b7025c36a08, 0x02f236d04753d5b4 }, // 5^59
+    { 0x9f4f2726179a2245, 0x01d762422c946590 }, // 5^60
+    { 0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5 }, // 5^61
+    { 0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2 }, // 5^62
+    { 0x9b934c3b330c8577, 0x63cc55f49f88eb2f }, // 5^63
+    { 0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb }, // 5^64
+    { 0xf316271c7fc3908a, 0x8bef464e3945ef7a }, // 5^65
+    { 0x97edd871cfda3a56, 0x97758bf0e3cbb5ac }, // 5^66
+    { 0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317 }, // 5^67
+    { 0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd }, // 5^68
+    { 0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a }, // 5^69
+    { 0xb975d6b6ee39e436, 0xb3e2fd538e122b44 }, // 5^70
+    { 0xe7d34c64a9c85d44, 0x60dbbca87196b616 }, // 5^71
+    { 0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd }, // 5^72
+    { 0xb51d13aea4a488dd, 0x6babab6398bdbe41 }, // 5^73
+    { 0xe264589a4dcdab14, 0xc696963c7eed2dd1 }, // 5^74
+    { 0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2 }, // 5^75
+    { 0xb0de65388cc8ada8, 0x3b25a55f43294bcb }, // 5^76
+    { 0xdd15fe86affad912, 0x49ef0eb713f39ebe }, // 5^77
+    { 0x8a2dbf142dfcc7ab, 0x6e3569326c784337 }, // 5^78
+    { 0xacb92ed9397bf996, 0x49c2c37f07965404 }, // 5^79
+    { 0xd7e77a8f87daf7fb, 0xdc33745ec97be906 }, // 5^80
+    { 0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3 }, // 5^81
+    { 0xa8acd7c0222311bc, 0xc40832ea0d68ce0c }, // 5^82
+    { 0xd2d80db02aabd62b, 0xf50a3fa490c30190 }, // 5^83
+    { 0x83c7088e1aab65db, 0x792667c6da79e0fa }, // 5^84
+    { 0xa4b8cab1a1563f52, 0x577001b891185938 }, // 5^85
+    { 0xcde6fd5e09abcf26, 0xed4c0226b55e6f86 }, // 5^86
+    { 0x80b05e5ac60b6178, 0x544f8158315b05b4 }, // 5^87
+    { 0xa0dc75f1778e39d6, 0x696361ae3db1c721 }, // 5^88
+    { 0xc913936dd571c84c, 0x03bc3a19cd1e38e9 }, // 5^89
+    { 0xfb5878494ace3a5f, 0x04ab48a04065c723 }, // 5^90
+    { 0x9d174b2dcec0e47b, 0x62eb0d64283f9c76 }, // 5^91
+    { 0xc45d1df942711d9a, 0x3ba5d0bd324f8394 }, // 5^92
+    { 0xf5746577930d6500, 0xca8f44ec7ee36479 }, // 5^93
+    { 0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb }, // 5^94
+    { 0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e }, // 5^95
+    { 0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e }, // 5^96
+    { 0x95d04aee3b80ece5, 0xbba1f1d158724a12 }, // 5^97
+    { 0xbb445da9ca61281f, 0x2a8a6e45ae8edc97 }, // 5^98
+    { 0xea1575143cf97226, 0xf52d09d71a3293bd }, // 5^99
+    { 0x924d692ca61be758, 0x593c2626705f9c56 }, // 5^100
+    { 0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c }, // 5^101
+    { 0xe498f455c38b997a, 0x0b6dfb9c0f956447 }, // 5^102
+    { 0x8edf98b59a373fec, 0x4724bd4189bd5eac }, // 5^103
+    { 0xb2977ee300c50fe7, 0x58edec91ec2cb657 }, // 5^104
+    { 0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed }, // 5^105
+    { 0x8b865b215899f46c, 0xbd79e0d20082ee74 }, // 5^106
+    { 0xae67f1e9aec07187, 0xecd8590680a3aa11 }, // 5^107
+    { 0xda01ee641a708de9, 0xe80e6f4820cc9495 }, // 5^108
+    { 0x884134fe908658b2, 0x3109058d147fdcdd }, // 5^109
+    { 0xaa51823e34a7eede, 0xbd4b46f0599fd415 }, // 5^110
+    { 0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a }, // 5^111
+    { 0x850fadc09923329e, 0x03e2cf6bc604ddb0 }, // 5^112
+    { 0xa6539930bf6bff45, 0x84db8346b786151c }, // 5^113
+    { 0xcfe87f7cef46ff16, 0xe612641865679a63 }, // 5^114
+    { 0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e }, // 5^115
+    { 0xa26da3999aef7749, 0xe3be5e330f38f09d }, // 5^116
+    { 0xcb090c8001ab551c, 0x5cadf5bfd3072cc5 }, // 5^117
+    { 0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6 }, // 5^118
+    { 0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa }, // 5^119
+    { 0xc646d63501a1511d, 0xb281e1fd541501b8 }, // 5^120
+    { 0xf7d88bc24209a565, 0x1f225a7ca91a4226 }, // 5^121
+    { 0x9ae757596946075f, 0x3375788de9b06958 }, // 5^122
+    { 0xc1a12d2fc3978937, 0x0052d6b1641c83ae }, // 5^123
+    { 0xf209787bb47d6b84, 0xc0678c5dbd23a49a }, // 5^124
+    { 0x9745eb4d50ce6332, 0xf840b7ba963646e0 }, // 5^125
+    { 0xbd176620a501fbff, 0xb650e5a93bc3d898 }, // 5^126
+    { 0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe }, // 5^127
+    { 0x93ba47c980e98cdf, 0xc66f336c36b10137 }, // 5^128
+    { 0xb8a8d9bbe123f017, 0xb80b0047445d4184 }, // 5^129
+    { 0xe6d3102ad96cec1d, 0xa60dc059157491e5 }, // 5^130
+    { 0x9043ea1ac7e41392, 0x87c89837ad68db2f }, // 5^131
+    { 0xb454e4a179dd1877, 0x29babe4598c311fb }, // 5^132
+    { 0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a }, // 5^133
+    { 0x8ce2529e2734bb1d, 0x1899e4a65f58660c }, // 5^134
+    { 0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f }, // 5^135
+    { 0xdc21a1171d42645d, 0x76707543f4fa1f73 }, // 5^136
+    { 0x899504ae72497eba, 0x6a06494a791c53a8 }, // 5^137
+    { 0xabfa45da0edbde69, 0x0487db9d17636892 }, // 5^138
+    { 0xd6f8d7509292d603, 0x45a9d2845d3c42b6 }, // 5^139
+    { 0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2 }, // 5^140
+    { 0xa7f26836f282b732, 0x8e6cac7768d7141e }, // 5^141
+    { 0xd1ef0244af2364ff, 0x3207d795430cd926 }, // 5^142
+    { 0x8335616aed761f1f, 0x7f44e6bd49e807b8 }, // 5^143
+    { 0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6 }, // 5^144
+    { 0xcd036837130890a1, 0x36dba887c37a8c0f }, // 5^145
+    { 0x802221226be55a64, 0xc2494954da2c9789 }, // 5^146
+    { 0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c }, // 5^147
+    { 0xc83553c5c8965d3d, 0x6f92829494e5acc7 }, // 5^148
+    { 0xfa42a8b73abbf48c, 0xcb772339ba1f17f9 }, // 5^149
+    { 0x9c69a97284b578d7, 0xff2a760414536efb }, // 5^150
+    { 0xc38413cf25e2d70d, 0xfef5138519684aba }, // 5^151
+    { 0xf46518c2ef5b8cd1, 0x7eb258665fc25d69 }, // 5^152
+    { 0x98bf2f79d5993802, 0xef2f773ffbd97a61 }, // 5^153
+    { 0xbeeefb584aff8603, 0xaafb550ffacfd8fa }, // 5^154
+    { 0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38 }, // 5^155
+    { 0x952ab45cfa97a0b2, 0xdd945a747bf26183 }, // 5^156
+    { 0xba756174393d88df, 0x94f971119aeef9e4 }, // 5^157
+    { 0xe912b9d1478ceb17, 0x7a37cd5601aab85d }, // 5^158
+    { 0x91abb422ccb812ee, 0xac62e055c10ab33a }, // 5^159
+    { 0xb616a12b7fe617aa, 0x577b986b314d6009 }, // 5^160
+    { 0xe39c49765fdf9d94, 0xed5a7e85fda0b80b }, // 5^161
+    { 0x8e41ade9fbebc27d, 0x14588f13be847307 }, // 5^162
+    { 0xb1d219647ae6b31c, 0x596eb2d8ae258fc8 }, // 5^163
+    { 0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb }, // 5^164
+    { 0x8aec23d680043bee, 0x25de7bb9480d5854 }, // 5^165
+    { 0xada72ccc20054ae9, 0xaf561aa79a10ae6a }, // 5^166
+    { 0xd910f7ff28069da4, 0x1b2ba1518094da04 }, // 5^167
+    { 0x87aa9aff79042286, 0x90fb44d2f05d0842 }, // 5^168
+    { 0xa99541bf57452b28, 0x353a1607ac744a53 }, // 5^169
+    { 0xd3fa922f2d1675f2, 0x42889b8997915ce8 }, // 5^170
+    { 0x847c9b5d7c2e09b7, 0x69956135febada11 }, // 5^171
+    { 0xa59bc234db398c25, 0x43fab9837e699095 }, // 5^172
+    { 0xcf02b2c21207ef2e, 0x94f967e45e03f4bb }, // 5^173
+    { 0x8161afb94b44f57d, 0x1d1be0eebac278f5 }, // 5^174
+    { 0xa1ba1ba79e1632dc, 0x6462d92a69731732 }, // 5^175
+    { 0xca28a291859bbf93, 0x7d7b8f7503cfdcfe }, // 5^176
+    { 0xfcb2cb35e702af78, 0x5cda735244c3d43e }, // 5^177
+    { 0x9defbf01b061adab, 0x3a0888136afa64a7 }, // 5^178
+    { 0xc56baec21c7a1916, 0x088aaa1845b8fdd0 }, // 5^179
+    { 0xf6c69a72a3989f5b, 0x8aad549e57273d45 }, // 5^180
+    { 0x9a3c2087a63f6399, 0x36ac54e2f678864b }, // 5^181
+    { 0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd }, // 5^182
+    { 0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5 }, // 5^183
+    { 0x969eb7c47859e743, 0x9f644ae5a4b1b325 }, // 5^184
+    { 0xbc4665b596706114, 0x873d5d9f0dde1fee }, // 5^185
+    { 0xeb57ff22fc0c7959, 0xa90cb506d155a7ea }, // 5^186
+    { 0x9316ff75dd87cbd8, 0x09a7f12442d588f2 }, // 5^187
+    { 0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f }, // 5^188
+    { 0xe5d3ef282a242e81, 0x8f1668c8a86da5fa }, // 5^189
+    { 0x8fa475791a569d10, 0xf96e017d694487bc }, // 5^190
+    { 0xb38d92d760ec4455, 0x37c981dcc395a9ac }, // 5^191
+    { 0xe070f78d3927556a, 0x85bbe253f47b1417 }, // 5^192
+    { 0x8c469ab843b89562, 0x93956d7478ccec8e }, // 5^193
+    { 0xaf58416654a6babb, 0x387ac8d1970027b2 }, // 5^194
+    { 0xdb2e51bfe9d0696a, 0x06997b05fcc0319e }, // 5^195
+    { 0x88fcf317f22241e2, 0x441fece3bdf81f03 }, // 5^196
+    { 0xab3c2fddeeaad25a, 0xd527e81cad7626c3 }, // 5^197
+    { 0xd60b3bd56a5586f1, 0x8a71e223d8d3b074 }, // 5^198
+    { 0x85c7056562757456, 0xf6872d5667844e49 }, // 5^199
+    { 0xa738c6bebb12d16c, 0xb428f8ac016561db }, // 5^200
+    { 0xd106f86e69d785c7, 0xe13336d701beba52 }, // 5^201
+    { 0x82a45b450226b39c, 0xecc0024661173473 }, // 5^202
+    { 0xa34d721642b06084, 0x27f002d7f95d0190 }, // 5^203
+    { 0xcc20ce9bd35c78a5, 0x31ec038df7b441f4 }, // 5^204
+    { 0xff290242c83396ce, 0x7e67047175a15271 }, // 5^205
+    { 0x9f79a169bd203e41, 0x0f0062c6e984d386 }, // 5^206
+    { 0xc75809c42c684dd1, 0x52c07b78a3e60868 }, // 5^207
+    { 0xf92e0c3537826145, 0xa7709a56ccdf8a82 }, // 5^208
+    { 0x9bbcc7a142b17ccb, 0x88a66076400bb691 }, // 5^209
+    { 0xc2abf989935ddbfe, 0x6acff893d00ea435 }, // 5^210
+    { 0xf356f7ebf83552fe, 0x0583f6b8c4124d43 }, // 5^211
+    { 0x98165af37b2153de, 0xc3727a337a8b704a }, // 5^212
+    { 0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c }, // 5^213
+    { 0xeda2ee1c7064130c, 0x1162def06f79df73 }, // 5^214
+    { 0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8 }, // 5^215
+    { 0xb9a74a0637ce2ee1, 0x6d953e2bd7173692 }, // 5^216
+    { 0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437 }, // 5^217
+    { 0x910ab1d4db9914a0, 0x1d9c9892400a22a2 }, // 5^218
+    { 0xb54d5e4a127f59c8, 0x2503beb6d00cab4b }, // 5^219
+    { 0xe2a0b5dc971f303a, 0x2e44ae64840fd61d }, // 5^220
+    { 0x8da471a9de737e24, 0x5ceaecfed289e5d2 }, // 5^221
+    { 0xb10d8e1456105dad, 0x7425a83e872c5f47 }, // 5^222
+    { 0xdd50f1996b947518, 0xd12f124e28f77719 }, // 5^223
+    { 0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f }, // 5^224
+    { 0xace73cbfdc0bfb7b, 0x636cc64d1001550b }, // 5^225
+    { 0xd8210befd30efa5a, 0x3c47f7e05401aa4e }, // 5^226
+    { 0x8714a775e3e95c78, 0x65acfaec34810a71 }, // 5^227
+    { 0xa8d9d1535ce3b396, 0x7f1839a741a14d0d }, // 5^228
+    { 0xd31045a8341ca07c, 0x1ede48111209a050 }, // 5^229
+    { 0x83ea2b892091e44d, 0x934aed0aab460432 }, // 5^230
+    { 0xa4e4b66b68b65d60, 0xf81da84d5617853f }, // 5^231
+    { 0xce1de40642e3f4b9, 0x36251260ab9d668e }, // 5^232
+    { 0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019 }, // 5^233
+    { 0xa1075a24e4421730, 0xb24cf65b8612f81f }, // 5^234
+    { 0xc94930ae1d529cfc, 0xdee033f26797b627 }, // 5^235
+    { 0xfb9b7cd9a4a7443c, 0x169840ef017da3b1 }, // 5^236
+    { 0x9d412e0806e88aa5, 0x8e1f289560ee864e }, // 5^237
+    { 0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2 }, // 5^238
+    { 0xf5b5d7ec8acb58a2, 0xae10af696774b1db }, // 5^239
+    { 0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29 }, // 5^240
+    { 0xbff610b0cc6edd3f, 0x17fd090a58d32af3 }, // 5^241
+    { 0xeff394dcff8a948e, 0xddfc4b4cef07f5b0 }, // 5^242
+    { 0x95f83d0a1fb69cd9, 0x4abdaf101564f98e }, // 5^243
+    { 0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1 }, // 5^244
+    { 0xea53df5fd18d5513, 0x84c86189216dc5ed }, // 5^245
+    { 0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4 }, // 5^246
+    { 0xb7118682dbb66a77, 0x3fbc8c33221dc2a1 }, // 5^247
+    { 0xe4d5e82392a40515, 0x0fabaf3feaa5334a }, // 5^248
+    { 0x8f05b1163ba6832d, 0x29cb4d87f2a7400e }, // 5^249
+    { 0xb2c71d5bca9023f8, 0x743e20e9ef511012 }, // 5^250
+    { 0xdf78e4b2bd342cf6, 0x914da9246b255416 }, // 5^251
+    { 0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e }, // 5^252
+    { 0xae9672aba3d0c320, 0xa184ac2473b529b1 }, // 5^253
+    { 0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e }, // 5^254
+    { 0x8865899617fb1871, 0x7e2fa67c7a658892 }, // 5^255
+    { 0xaa7eebfb9df9de8d, 0xddbb901b98feeab7 }, // 5^256
+    { 0xd51ea6fa85785631, 0x552a74227f3ea565 }, // 5^257
+    { 0x8533285c936b35de, 0xd53a88958f87275f }, // 5^258
+    { 0xa67ff273b8460356, 0x8a892abaf368f137 }, // 5^259
+    { 0xd01fef10a657842c, 0x2d2b7569b0432d85 }, // 5^260
+    { 0x8213f56a67f6b29b, 0x9c3b29620e29fc73 }, // 5^261
+    { 0xa298f2c501f45f42, 0x8349f3ba91b47b8f }, // 5^262
+    { 0xcb3f2f7642717713, 0x241c70a936219a73 }, // 5^263
+    { 0xfe0efb53d30dd4d7, 0xed238cd383aa0110 }, // 5^264
+    { 0x9ec95d1463e8a506, 0xf4363804324a40aa }, // 5^265
+    { 0xc67bb4597ce2ce48, 0xb143c6053edcd0d5 }, // 5^266
+    { 0xf81aa16fdc1b81da, 0xdd94b7868e94050a }, // 5^267
+    { 0x9b10a4e5e9913128, 0xca7cf2b4191c8326 }, // 5^268
+    { 0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0 }, // 5^269
+    { 0xf24a01a73cf2dccf, 0xbc633b39673c8cec }, // 5^270
+    { 0x976e41088617ca01, 0xd5be0503e085d813 }, // 5^271
+    { 0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18 }, // 5^272
+    { 0xec9c459d51852ba2, 0xddf8e7d60ed1219e }, // 5^273
+    { 0x93e1ab8252f33b45, 0xcabb90e5c942b503 }, // 5^274
+    { 0xb8da1662e7b00a17, 0x3d6a751f3b936243 }, // 5^275
+    { 0xe7109bfba19c0c9d, 0x0cc512670a783ad4 }, // 5^276
+    { 0x906a617d450187e2, 0x27fb2b80668b24c5 }, // 5^277
+    { 0xb484f9dc9641e9da, 0xb1f9f660802dedf6 }, // 5^278
+    { 0xe1a63853bbd26451, 0x5e7873f8a0396973 }, // 5^279
+    { 0x8d07e33455637eb2, 0xdb0b487b6423e1e8 }, // 5^280
+    { 0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62 }, // 5^281
+    { 0xdc5c5301c56b75f7, 0x7641a140cc7810fb }, // 5^282
+    { 0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d }, // 5^283
+    { 0xac2820d9623bf429, 0x546345fa9fbdcd44 }, // 5^284
+    { 0xd732290fbacaf133, 0xa97c177947ad4095 }, // 5^285
+    { 0x867f59a9d4bed6c0, 0x49ed8eabcccc485d }, // 5^286
+    { 0xa81f301449ee8c70, 0x5c68f256bfff5a74 }, // 5^287
+    { 0xd226fc195c6a2f8c, 0x73832eec6fff3111 }, // 5^288
+    { 0x83585d8fd9c25db7, 0xc831fd53c5ff7eab }, // 5^289
+    { 0xa42e74f3d032f525, 0xba3e7ca8b77f5e55 }, // 5^290
+    { 0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb }, // 5^291
+    { 0x80444b5e7aa7cf85, 0x7980d163cf5b81b3 }, // 5^292
+    { 0xa0555e361951c366, 0xd7e105bcc332621f }, // 5^293
+    { 0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7 }, // 5^294
+    { 0xfa856334878fc150, 0xb14f98f6f0feb951 }, // 5^295
+    { 0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3 }, // 5^296
+    { 0xc3b8358109e84f07, 0x0a862f80ec4700c8 }, // 5^297
+    { 0xf4a642e14c6262c8, 0xcd27bb612758c0fa }, // 5^298
+    { 0x98e7e9cccfbd7dbd, 0x8038d51cb897789c }, // 5^299
+    { 0xbf21e44003acdd2c, 0xe0470a63e6bd56c3 }, // 5^300
+    { 0xeeea5d5004981478, 0x1858ccfce06cac74 }, // 5^301
+    { 0x95527a5202df0ccb, 0x0f37801e0c43ebc8 }, // 5^302
+    { 0xbaa718e68396cffd, 0xd30560258f54e6ba }, // 5^303
+    { 0xe950df20247c83fd, 0x47c6b82ef32a2069 }, // 5^304
+    { 0x91d28b7416cdd27e, 0x4cdc331d57fa5441 }, // 5^305
+    { 0xb6472e511c81471d, 0xe0133fe4adf8e952 }, // 5^306
+    { 0xe3d8f9e563a198e5, 0x58180fddd97723a6 }, // 5^307
+    { 0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648 }, // 5^308
+};
+
+constexpr double EXACT_POWERS_OF_TEN[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                           1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+/// binary64: a normalized mantissa of 52 bits and a biased exponent
+struct adjusted_mantissa {
+    uint64_t mantissa = 0;
+    int32_t power2 = 0;
+
+    bool operator==(const adjusted_mantissa& other) const
+    {
+        return mantissa == other.mantissa && power2 == other.power2;
+    }
+    bool operator!=(const adjusted_mantissa& other) const { return !(*this == other); }
+};
+
+constexpr int MANTISSA_EXPLICIT_BITS = 52;
+constexpr int MINIMUM_EXPONENT = -1023;
+constexpr int INFINITE_POWER = 0x7FF;
+
+FLATTEN_INLINE void full_multiplication(uint64_t a, uint64_t b, uint64_t* high, uint64_t* low)
+{
+#ifdef __SIZEOF_INT128__
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    *high = static_cast<uint64_t>(r >> 64);
+    *low = static_cast<uint64_t>(r);
+#else
+    uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_hi = a_hi * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    *high = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    *low = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+#endif
+}
+
+/// Eisel-Lemire: the double nearest to `w * 10^q`
+adjusted_mantissa compute_float(int64_t q, uint64_t w)
+{
+    adjusted_mantissa answer;
+    if (w == 0 || q < SMALLEST_POWER_OF_FIVE) {
+        return answer;
+    }
+    if (q > LARGEST_POWER_OF_FIVE) {
+        answer.power2 = INFINITE_POWER;
+        return answer;
+    }
+
+    int lz = __builtin_clzll(w);
+    w <<= lz;
+
+    // the product's 55 (52 + 3) most significant bits must be exact. When they may be affected by the
+    // truncated bits of 5^q, use the next 64 bits of 5^q as well
+    const power_of_five& power = POWERS_OF_FIVE[q - SMALLEST_POWER_OF_FIVE];
+    uint64_t high, low;
+    full_multiplication(w, power.high, &high, &low);
+    constexpr uint64_t PRECISION_MASK = 0xFFFFFFFFFFFFFFFFULL >> (MANTISSA_EXPLICIT_BITS + 3);
+    if ((high & PRECISION_MASK) == PRECISION_MASK) {
+        uint64_t second_high, second_low;
+        full_multiplication(w, power.low, &second_high, &second_low);
+        low += second_high;
+        if (second_high > low) {
+            high++;
+        }
+    }
+
+    int upperbit = static_cast<int>(high >> 63);
+    int shift = upperbit + 64 - MANTISSA_EXPLICIT_BITS - 3;
+    answer.mantissa = high >> shift;
+    // floor(log2(10^q)) = floor(q * log2(10)) for q in [-342, 308]
+    int32_t power10_to_2 = static_cast<int32_t>((((152170 + 65536) * q) >> 16) + 63);
+    answer.power2 = power10_to_2 + upperbit - lz - MINIMUM_EXPONENT;
+
+    if (answer.power2 <= 0) {
+        // subnormal
+        if (-answer.power2 + 1 >= 64) {
+            answer.power2 = 0;
+            answer.mantissa = 0;
+            return answer;
+        }
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += (answer.mantissa & 1);
+        answer.mantissa >>= 1;
+        answer.power2 = (answer.mantissa < (uint64_t(1) << MANTISSA_EXPLICIT_BITS)) ? 0 : 1;
+        return answer;
+    }
+
+    // exactly halfway between two doubles (only possible for small q): round to even
+    if (low <= 1 && q >= -4 && q <= 23 && (answer.mantissa & 3) == 1) {
+        if ((answer.mantissa << shift) == high) {
+            answer.mantissa &= ~uint64_t(1);
+        }
+    }
+
+    answer.mantissa += (answer.mantissa & 1);
+    answer.mantissa >>= 1;
+    if (answer.mantissa >= (uint64_t(2) << MANTISSA_EXPLICIT_BITS)) {
+        answer.mantissa = (uint64_t(1) << MANTISSA_EXPLICIT_BITS);
+        answer.power2++;
+    }
+    answer.mantissa &= ~(uint64_t(1) << MANTISSA_EXPLICIT_BITS);
+    if (answer.power2 >= INFINITE_POWER) {
+        answer.power2 = INFINITE_POWER;
+        answer.mantissa = 0;
+    }
+    return answer;
+}
+
+FLATTEN_INLINE double to_double(bool negative, const adjusted_mantissa& am)
+{
+    uint64_t word = am.mantissa | (static_cast<uint64_t>(am.power2) << MANTISSA_EXPLICIT_BITS) |
+                    (static_cast<uint64_t>(negative) << 63);
+    double d;
+    memcpy(&d, &word, sizeof(d));
+    return d;
+}
+
+/// convert the number `text` (already split into `negative * w * 10^q`) to double. `truncated` is set when
+/// `w` holds only the first 19 significant digits of the number
+double decimal_to_double(const char* text, size_t len, bool negative, uint64_t w, int64_t q, bool truncated)
+{
+#if FLT_EVAL_METHOD == 0
+    if (!truncated && w <= (uint64_t(1) << 53) && q >= -22 && q <= 22) {
+        double d = static_cast<double>(w);
+        d = q < 0 ? d / EXACT_POWERS_OF_TEN[-q] : d * EXACT_POWERS_OF_TEN[q];
+        return negative ? -d : d;
+    }
+#endif
+
+    adjusted_mantissa am = compute_float(q, w);
+    if (truncated && am != compute_float(q, w + 1)) {
+        // the dropped digits decide the rounding, convert the whole text
+        double d = 0.0;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        if (std::from_chars(text, text + len, d).ec == std::errc()) {
+            return d;
+        }
+#else
+        std::string str(text, len);
+        char* str_end = nullptr;
+        d = strtod(str.c_str(), &str_end);
+        if (str_end != str.c_str()) {
+            return d;
+        }
+#endif
+    }
+    return to_double(negative, am);
+}
+} // namespace
+
+namespace
+{
+/// return the end of the array or object that starts at `value` (just past its closing bracket), found by matching
+/// the brackets outside of strings. Its content is not validated. Return nullptr if it is not closed
+const char* skip_container(const char* value, const char* end)
+{
+    size_t depth = 0;
+    for (const char* p = value; p < end; ++p) {
+        switch (*p) {
+        case '"':
+            // jump to the closing quote: the next one that is not escaped
+            for (;;) {
+                p = static_cast<const char*>(memchr(p + 1, '"', end - p - 1));
+                if (!p) {
+                    return nullptr;
+                }
+                const char* backslashes = p;
+                while (backslashes[-1] == '\\') {
+                    --backslashes;
+                }
+                if ((p - backslashes) % 2 == 0) {
+                    break;
+                }
+            }
+            break;
+        case '[':
+        case '{':
+            ++depth;
+            break;
+        case ']':
+        case '}':
+            if (--depth == 0) {
+                return p + 1;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return nullptr;
+}
+
+/// true for the handlers that keep nested arrays and objects as raw text (see `lazy_builder`), they provide
+/// `deferred_container(raw, len, is_object)` and `expand_root`, set to parse the root itself
+template <typename Handler, typename = void> struct defers_containers : std::false_type {
+};
+template <typename Handler>
+struct defers_containers<Handler, std::void_t<decltype(&Handler::deferred_container)>> : std::true_type {
+};
+
+/// true for the handlers that may skip arrays and objects (see `query_matcher`), they provide
+/// `skips_container(is_object)`, asked before every array and object: when it returns true, the container is
+/// skipped over by matching its brackets and none of its content is reported
+template <typename Handler, typename = void> struct skips_containers : std::false_type {
+};
+template <typename Handler>
+struct skips_containers<Handler, std::void_t<decltype(&Handler::skips_container)>> : std::true_type {
+};
+
+/// The arrays and objects being parsed by `reader::parse_value`, innermost last: one bit per level, set for
+/// objects. The first `INLINE_WORDS * 64` levels are kept in place, which covers the default
+/// `parse_limits::max_depth`. Deeper levels (when the limit allows them) move to the heap
+struct container_stack {
+    static constexpr size_t INLINE_WORDS = 16;
+
+    uint64_t inline_words[INLINE_WORDS];
+    std::vector<uint64_t> heap_words;
+    uint64_t* words = inline_words;
+    size_t capacity = INLINE_WORDS * 64;
+    size_t depth = 0;
+
+    container_stack() = default;
+    container_stack(const container_stack&) = delete;
+    container_stack& operator=(const container_stack&) = delete;
+
+    FLATTEN_INLINE bool empty() const { return depth == 0; }
+    FLATTEN_INLINE bool top_is_object() const { return (words[(depth - 1) / 64] >> ((depth - 1) % 64)) & 1; }
+    FLATTEN_INLINE void pop() { --depth; }
+    FLATTEN_INLINE void push(bool is_object)
+    {
+        if (depth == capacity) {
+            grow();
+        }
+        uint64_t bit = uint64_t(1) << (depth % 64);
+        uint64_t& word = words[depth / 64];
+        word = is_object ? (word | bit) : (word & ~bit);
+        ++depth;
+    }
+
+    void grow()
+    {
+        std::vector<uint64_t> larger(capacity / 64 * 2);
+        std::copy(words, words + capacity / 64, larger.begin());
+        heap_words.swap(larger);
+        words = heap_words.data();
+        capacity = heap_words.size() * 64;
+    }
+};
+
+/// The parser. It validates the input and reports every value to `Handler`, which is a template parameter so the
+/// callbacks of the internal handlers (e.g. the DOM builder) are inlined. It does not recurse: the open arrays and
+/// objects are kept in a `container_stack`, so hostile nesting can not overflow the stack, and the input is
+/// checked against the `parse_limits` of the context as it goes.
+/// `Handler` provides the same callbacks as `tinyjson::handler`, except for strings and keys which are passed
+/// raw: `string_value(raw, len, has_escapes)` and `key(raw, len, has_escapes)`, where `raw` points to the
+/// string inside the input (without the quotes) and `has_escapes` tells if it needs decoding
+template <typename Handler> struct reader {
+    parse_context& ctx;
+    Handler& handler;
+
+    const char* parse_string(const char* str, bool key);
+    const char* parse_number(const char* num);
+    const char* parse_scalar(const char* value);
+    const char* parse_member_name(const char* value);
+    const char* parse_value(const char* value);
+
+    /// true when the array or object at `value` is passed over by matching its brackets instead of being parsed
+    /// (see `skips_containers` and `defers_containers`). `at_root` is true for the value given to `parse_value`
+    FLATTEN_INLINE bool passes_over([[maybe_unused]] const char* value, [[maybe_unused]] bool at_root)
+    {
+        if constexpr (skips_containers<Handler>::value) {
+            return handler.skips_container(*value == '{');
+        } else if constexpr (defers_containers<Handler>::value) {
+            return !(at_root && handler.expand_root);
+        } else {
+            return false;
+        }
+    }
+};
+
+/* Parse a string (or an object member's name), and report it to the handler. */
+template <typename Handler> const char* reader<Handler>::parse_string(const char* str, bool key)
+{
+    const char* ptr = str + 1;
+    bool has_escapes = false;
+    if (!is_char(str, ctx.end, '\"')) {
+        return ctx.unexpected(str);
+    } /* not a string! */
+
+    const char* closing = ctx.string_end(str);
+    if (closing) {
+        ptr = closing;
+        has_escapes = memchr(str + 1, '\\', closing - str - 1) != nullptr;
+    } else {
+        while (ptr < ctx.end && *ptr != '\"') {
+            if (*ptr++ == '\\') {
+                has_escapes = true;
+                if (ptr < ctx.end)
+                    ptr++; /* Skip escaped quotes. */
+            }
+        }
+    }
+
+    if (ptr == ctx.end) {
+        return ctx.fail(parse_error::UNTERMINATED_STRING, str);
+    }
+
+    size_t len = ptr - (str + 1);
+    if (len > ctx.limits.max_string_length) {
+        return ctx.fail(parse_error::STRING_TOO_LONG, str);
+    }
+    if (has_escapes) {
+        const char* bad_escape = find_bad_escape(str + 1, ptr, ctx.utf8 == utf8_mode::STRICT);
+        if (bad_escape) {
+            return ctx.fail(parse_error::BAD_ESCAPE, bad_escape);
+        }
+    }
+    const char* raw = str + 1;
+    if (ctx.repair && find_invalid_utf8(raw, ptr)) {
+        repair_utf8(raw, ptr, &ctx.repaired);
+        raw = ctx.repaired.data();
+        len = ctx.repaired.length();
+    }
+    bool ok = key ? handler.key(raw, len, has_escapes) : handler.string_value(raw, len, has_escapes);
+    return ok ? ptr + 1 : ctx.fail(parse_error::STOPPED, str);
+}
+
+/* Parse the input text to generate a number, and report it to the handler. */
+template <typename Handler> const char* reader<Handler>::parse_number(const char* num)
+{
+    const char* start = num;
+    const char* end = ctx.end;
+    bool negative = false;
+    // no fraction and no exponent
+    bool is_integer = true;
+    // the first 19 significant digits are accumulated into `mantissa`
+    uint64_t mantissa = 0;
+    int significant_digits = 0;
+    bool truncated = false;
+    // decimal exponent of `mantissa`
+    int64_t exponent = 0;
+
+    if (is_char(num, end, '-'))
+        negative = true, num++; /* Has sign? */
+    const char* digits = num;
+    if (is_char(num, end, '0'))
+        num++; /* is zero */
+    if (num < end && *num >= '1' && *num <= '9') {
+        do {
+            uint64_t digit = *num++ - '0';
+            if (significant_digits < 19) {
+                mantissa = mantissa * 10 + digit;
+                if (mantissa) {
+                    ++significant_digits;
+                }
+            } else {
+                truncated |= digit != 0;
+                ++exponent;
+            }
+        } while (num < end && *num >= '0' && *num <= '9'); /* Number? */
+    }
+    const char* digits_end = num;
+    if (digits_end == digits) {
+        return ctx.unexpected(num); /* no digit */
+    }
+    if (is_char(num, end, '.') && num + 1 < end && num[1] >= '0' && num[1] <= '9') {
+        is_integer = false;
+        num++;
+        do {
+            uint64_t digit = *num++ - '0';
+            if (significant_digits < 19) {
+                mantissa = mantissa * 10 + digit;
+                if (mantissa) {
+                    ++significant_digits;
+                }
+                --exponent;
+            } else {
+                truncated |= digit != 0;
+            }
+        } while (num < end && *num >= '0' && *num <= '9');
+    } /* Fractional part? */
+    if (is_char(num, end, 'e') || is_char(num, end, 'E')) /* Exponent? */
+    {
+        is_integer = false;
+        num++;
+        bool negative_exponent = false;
+        int64_t explicit_exponent = 0;
+        if (is_char(num, end, '+'))
+            num++;
+        else if (is_char(num, end, '-'))
+            negative_exponent = true, num++; /* With sign? */
+        if (num == end || *num < '0' || *num > '9') {
+            return ctx.unexpected(num); /* no digit */
+        }
+        while (num < end && *num >= '0' && *num <= '9') {
+            // larger exponents are out of range anyway, just don't overflow
+            if (explicit_exponent < 0x10000000) {
+                explicit_exponent = (explicit_exponent * 10) + (*num - '0');
+            }
+            num++;
+        }
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+
+    // integers are reported as such, unless they are out of the 64 bit range. `-0` is reported as a double,
+    // so its sign is not lost
+    if (is_integer && digits_end > digits && !(negative && mantissa == 0)) {
+        if (exponent == 0) {
+            // up to 19 digits
+            if (!negative) {
+                bool ok = mantissa <= uint64_t(INT64_MAX) ? handler.int64_value(static_cast<int64_t>(mantissa))
+                                                          : handler.uint64_value(mantissa);
+                return ok ? num : ctx.fail(parse_error::STOPPED, start);
+            } else if (mantissa <= (uint64_t(1) << 63)) {
+                bool ok = handler.int64_value(static_cast<int64_t>(0 - mantissa));
+                return ok ? num : ctx.fail(parse_error::STOPPED, start);
+            }
+        } else if (exponent == 1 && !negative) {
+            // 20 digits, may still fit an uint64_t (and is above `INT64_MAX` if it does)
+            uint64_t value = 0;
+            if (std::from_chars(digits, digits_end, value).ec == std::errc()) {
+                return handler.uint64_value(value) ? num : ctx.fail(parse_error::STOPPED, start);
+            }
+        }
+    }
+
+    double value = decimal_to_double(start, num - start, negative, mantissa, exponent, truncated);
+    return handler.double_value(value) ? num : ctx.fail(parse_error::STOPPED, start);
+}
+
+/// the length of the longest prefix of `text` shared with `null`, `true` or `false`. A malformed literal fails
+/// at the byte that follows it, e.g. at the `x` of `nulx` or `nullx`
+size_t literal_prefix_length(std::string_view text)
+{
+    size_t longest = 0;
+    for (std::string_view literal : { std::string_view("null"), std::string_view("true"), std::string_view("false") }) {
+        size_t length = 0;
+        while (length < literal.length() && length < text.length() && text[length] == literal[length]) {
+            ++length;
+        }
+        longest = std::max(longest, length);
+    }
+    return longest;
+}
+
+/* Parse a literal, a string or a number, and report it to the handler. */
+template <typename Handler> const char* reader<Handler>::parse_scalar(const char* value)
+{
+    size_t remaining = ctx.end - value;
+    if (remaining >= 4 && !memcmp(value, "null", 4)) {
+        return handler.null_value() ? value + 4 : ctx.fail(parse_error::STOPPED, value);
+    }
+
+    if (remaining >= 5 && !memcmp(value, "false", 5)) {
+        return handler.bool_value(false) ? value + 5 : ctx.fail(parse_error::STOPPED, value);
+    }
+
+    if (remaining >= 4 && !memcmp(value, "true", 4)) {
+        return handler.bool_value(true) ? value + 4 : ctx.fail(parse_error::STOPPED, value);
+    }
+
+    if (*value == '\"') {
+        return parse_string(value, false);
+    }
+
+    if (*value == '-' || (*value >= '0' && *value <= '9')) {
+        return parse_number(value);
+    }
+
+    return ctx.unexpected(value + literal_prefix_length(std::string_view(value, remaining))); /* failure. */
+}
+
+/* Parse an object member's name and the colon that follows it, and return the start of the member's value. */
+template <typename Handler> const char* reader<Handler>::parse_member_name(const char* value)
+{
+    value = ctx.skip(parse_string(value, true));
+    if (!value) {
+        return nullptr;
+    }
+
+    if (!is_char(value, ctx.end, ':')) {
+        return ctx.unexpected(value);
+    }
+    return ctx.skip(value + 1);
+}
+
+/* Parse a value, with all the arrays and objects nested in it, and report it to the handler. */
+template <typename Handler> const char* reader<Handler>::parse_value(const char* value)
+{
+    const char* end = ctx.end;
+    container_stack open;
+    for (;;) {
+        // `value` is where the next value starts
+        if (!value) {
+            return nullptr;
+        }
+        if (value == end) {
+            return ctx.fail(parse_error::UNEXPECTED_END, value);
+        }
+        if (++ctx.elements > ctx.limits.max_elements) {
+            return ctx.fail(parse_error::TOO_MANY_ELEMENTS, value);
+        }
+
+        if (*value != '[' && *value != '{') {
+            value = parse_scalar(value);
+            if (!value) {
+                return nullptr;
+            }
+        } else if (passes_over(value, open.empty())) {
+            const char* container_end = skip_container(value, end);
+            if (!container_end) {
+                return ctx.fail(parse_error::UNEXPECTED_END, end);
+            }
+            if constexpr (defers_containers<Handler>::value) {
+                if (!handler.deferred_container(value, container_end - value, *value == '{')) {
+                    return ctx.fail(parse_error::STOPPED, value);
+                }
+            }
+            value = container_end;
+        } else {
+            bool is_object = *value == '{';
+            if (open.depth >= ctx.limits.max_depth) {
+                return ctx.fail(parse_error::TOO_DEEP, value);
+            }
+            if (!(is_object ? handler.start_object() : handler.start_array())) {
+                return ctx.fail(parse_error::STOPPED, value);
+            }
+            value = ctx.skip(value + 1);
+            if (!is_char(value, end, is_object ? '}' : ']')) {
+                // the first item of the array or member of the object follows
+                open.push(is_object);
+                value = is_object ? parse_member_name(value) : value;
+                continue;
+            }
+            // empty array or object
+            if (!(is_object ? handler.end_object() : handler.end_array())) {
+                return ctx.fail(parse_error::STOPPED, value);
+            }
+            ++value;
+        }
+
+        // the value is complete: move to the next item of the innermost array or object, or close it (and then
+        // the containers that end with it)
+        for (;;) {
+            if (open.empty()) {
+                return value;
+            }
+            value = ctx.skip(value);
+            bool is_object = open.top_is_object();
+            if (is_char(value, end, ',')) {
+                value = ctx.skip(value + 1);
+                value = is_object ? parse_member_name(value) : value;
+                break;
+            }
+            if (!is_char(value, end, is_object ? '}' : ']')) {
+                return ctx.unexpected(value); /* malformed. */
+            }
+            if (!(is_object ? handler.end_object() : handler.end_array())) {
+                return ctx.fail(parse_error::STOPPED, value);
+            }
+            open.pop();
+            ++value;
+        }
+    }
+}
+
+/// build the structural index of the input into `index` and let `ctx` use it, when it pays off
+void attach_structural_index(parse_context& ctx, std::vector<uint32_t>& index)
+{
+    size_t len = ctx.end - ctx.begin;
+    // when the index can not be built (e.g. unbalanced quotes), let the parser find out where the input breaks.
+    // An oversized input is refused by `read` without indexing it
+    if (len < STRUCTURAL_INDEX_MIN_SIZE || get_simd_level() == simd_level::SCALAR || ctx.too_large()) {
+        return;
+    }
+    TINYJSON_STAT(stats_timer timer{ current_stats.index_ns });
+    if (build_structural_index(ctx.begin, len, &index)) {
+        ctx.index = index.data();
+    }
+}
+
+/// call once the parse is over: free `index` (a `thread_local` reused between parses) if it grew past
+/// `STRUCTURAL_INDEX_MAX_RETAINED`, so a thread does not keep the index of the largest input it ever parsed
+void release_structural_index(std::vector<uint32_t>& index)
+{
+    if (index.capacity() > STRUCTURAL_INDEX_MAX_RETAINED) {
+        std::vector<uint32_t>().swap(index);
+    }
+}
+
+/// parse the input described by `ctx`, reporting its values to `handler`
+template <typename Handler> parse_result read(parse_context& ctx, Handler& handler)
+{
+    if (!ctx.begin) {
+        // no input at all (e.g. a default constructed `std::string_view`)
+        return { parse_error::UNEXPECTED_END };
+    }
+    if (ctx.too_large()) {
+        return { parse_error::DOCUMENT_TOO_LARGE, ctx.limits.max_document_size, ctx.begin };
+    }
+    // the whole input is validated in one pass, which is much faster than checking the strings one by one
+    if (ctx.utf8 != utf8_mode::UNCHECKED) {
+        const char* invalid = find_invalid_utf8(ctx.begin, ctx.end);
+        if (invalid && ctx.utf8 == utf8_mode::STRICT) {
+            return { parse_error::INVALID_UTF8, static_cast<size_t>(invalid - ctx.begin), ctx.begin };
+        }
+        ctx.repair = invalid != nullptr;
+    }
+    reader<Handler> r{ ctx, handler };
+    const char* value_end = r.parse_value(ctx.skip(ctx.begin));
+    if (!value_end && ctx.error == parse_error::NONE) {
+        // every failure should be recorded, never report a missing value as a success
+        ctx.fail(parse_error::UNEXPECTED_END, ctx.begin);
+    } else if (value_end) {
+        // only whitespace may follow the value
+        const char* trailing = skip(value_end, ctx.end);
+        if (trailing != ctx.end) {
+            ctx.fail(parse_error::TRAILING_CONTENT, trailing);
+        }
+    }
+    return ctx.result();
+}
+
+/// the `reader` handler behind `tinyjson::parse(content, handler*)`: decodes the strings for the user's handler
+struct sax_adapter {
+    handler* h = nullptr;
+    /// the decoded strings, reused for the whole parse
+    std::string scratch;
+
+    FLATTEN_INLINE std::string_view decode(const char* raw, size_t len, bool has_escapes)
+    {
+        if (!has_escapes) {
+            return { raw, len };
+        }
+        scratch.resize(len);
+        return { scratch.data(), unescape_string(raw, len, scratch.data()) };
+    }
+
+    bool null_value() { return h->null_value(); }
+    bool bool_value(bool value) { return h->bool_value(value); }
+    bool int64_value(int64_t value) { return h->int64_value(value); }
+    bool uint64_value(uint64_t value) { return h->uint64_value(value); }
+    bool double_value(double value) { return h->double_value(value); }
+    bool string_value(const char* raw, size_t len, bool has_escapes)
+    {
+        return h->string_value(decode(raw, len, has_escapes));
+    }
+    bool key(const char* raw, size_t len, bool has_escapes) { return h->key(decode(raw, len, has_escapes)); }
+    bool start_object() { return h->start_object(); }
+    bool end_object() { return h->end_object(); }
+    bool start_array() { return h->start_array(); }
+    bool end_array() { return h->end_array(); }
+};
+
+/// the `reader` handler that fills bound C++ values (see `tinyjson::binding`) through their `bind_ops`
+struct bind_builder {
+    bind_target root;
+    /// the innermost array or object being parsed, its `ops` are null if it is skipped
+    bind_target parent;
+    /// false before the root value (and after it, if it is an array or an object)
+    bool has_parent = false;
+    /// the enclosing arrays and objects of `parent`, innermost last
+    std::vector<bind_target> stack;
+    /// the target of the object member whose name was just read
+    bind_target member;
+    bool has_member = false;
+    /// the decoded strings, reused for the whole parse
+    std::string scratch;
+
+    FLATTEN_INLINE std::string_view decode(const char* raw, size_t len, bool has_escapes)
+    {
+        if (!has_escapes) {
+            return { raw, len };
+        }
+        scratch.resize(len);
+        return { scratch.data(), unescape_string(raw, len, scratch.data()) };
+    }
+
+    /// set `target` to the value that receives the next value
+    FLATTEN_INLINE bool next(bind_target* target)
+    {
+        if (has_member) {
+            has_member = false;
+            *target = member;
+            return true;
+        }
+        if (!has_parent) {
+            *target = root;
+            return true;
+        }
+        if (!parent.ops) {
+            // the items of a skipped array are skipped too
+            *target = {};
+            return true;
+        }
+        return parent.ops->next_item(parent.object, target);
+    }
+
+    bool null_value()
+    {
+        bind_target target;
+        return next(&target) && (!target.ops || target.ops->null_value(target.object));
+    }
+    bool bool_value(bool value)
+    {
+        bind_target target;
+        return next(&target) && (!target.ops || target.ops->bool_value(target.object, value));
+    }
+    bool int64_value(int64_t value)
+    {
+        bind_target target;
+        return next(&target) && (!target.ops || target.ops->int64_value(target.object, value));
+    }
+    bool uint64_value(uint64_t value)
+    {
+        bind_target target;
+        return next(&target) && (!target.ops || target.ops->uint64_value(target.object, value));
+    }
+    bool double_value(double value)
+    {
+        bind_target target;
+        return next(&target) && (!target.ops || target.ops->double_value(target.object, value));
+    }
+    bool string_value(const char* raw, size_t len, bool has_escapes)
+    {
+        bind_target target;
+        return next(&target) &&
+               (!target.ops || target.ops->string_value(target.object, decode(raw, len, has_escapes)));
+    }
+    bool key(const char* raw, size_t len, bool has_escapes)
+    {
+        has_member = true;
+        if (!parent.ops) {
+            member = {};
+            return true;
+        }
+        return parent.ops->key(parent.object, decode(raw, len, has_escapes), &member);
+    }
+
+    FLATTEN_INLINE bool start_container(bool is_object)
+    {
+        bind_target target;
+        if (!next(&target)) {
+            return false;
+        }
+        bind_target frame;
+        if (target.ops && !(is_object ? target.ops->start_object(target.object, &frame)
+                                      : target.ops->start_array(target.object, &frame))) {
+            return false;
+        }
+        if (has_parent) {
+            stack.push_back(parent);
+        }
+        parent = frame;
+        has_parent = true;
+        return true;
+    }
+
+    FLATTEN_INLINE bool end_container()
+    {
+        if (stack.empty()) {
+            has_parent = false;
+        } else {
+            parent = stack.back();
+            stack.pop_back();
+        }
+        return true;
+    }
+
+    bool start_object() { return start_container(true); }
+    bool end_object() { return end_container(); }
+    bool start_array() { return start_container(false); }
+    bool end_array() { return end_container(); }
+};
+} // namespace
+
+/// the `reader` handler that builds the element tree
+struct dom_builder {
+    parse_context& ctx;
+    element* root = nullptr;
+    /// the innermost array or object being parsed, nullptr before the root value
+    element* parent = nullptr;
+    /// the enclosing arrays and objects of `parent`, innermost last
+    std::vector<element*> stack;
+    /// the object member whose name was just read, it receives the next value
+    element* member = nullptr;
+
+    dom_builder(parse_context& context, element* root_element)
+        : ctx(context)
+        , root(root_element)
+    {
+        stack.reserve(32);
+    }
+
+    /// return the element that receives the next value
+    FLATTEN_INLINE element* next()
+    {
+        if (member) {
+            element* item = member;
+            member = nullptr;
+            return item;
+        }
+        return parent ? append_child() : root;
+    }
+
+    /// append a new child to `parent`
+    FLATTEN_INLINE element* append_child()
+    {
+        TINYJSON_STAT(size_t capacity = parent->m_children.capacity());
+        element* item = &parent->append_new();
+        TINYJSON_STAT(if (parent->m_children.capacity() != capacity) {
+            count_allocation(parent->m_children.capacity() * sizeof(element));
+        });
+        return item;
+    }
+
+    /// count a parsed value of kind `kind` (when collecting statistics)
+    FLATTEN_INLINE void count_node([[maybe_unused]] element_kind kind)
+    {
+        TINYJSON_STAT(++current_stats.nodes[static_cast<size_t>(kind)]);
+    }
+
+    /// a new array or object was opened (when collecting statistics)
+    FLATTEN_INLINE void count_depth()
+    {
+        TINYJSON_STAT(current_stats.max_depth = std::max(current_stats.max_depth, static_cast<uint32_t>(stack.size())));
+    }
+
+    /// store the raw string `raw` into either `item`'s value or `item`'s property name
+    FLATTEN_INLINE void store_string(element* item, const char* raw, size_t len, bool has_escapes, bool property_name)
+    {
+        char* out = nullptr;
+        uint8_t flags = 0;
+        if (ctx.view && !ctx.is_repaired(raw)) {
+            // keep the raw string, the read accessors decode it if needed
+            out = const_cast<char*>(raw);
+            flags = property_name ? (element::F_BORROWED_NAME | element::F_UNTERMINATED_NAME |
+                                     (has_escapes ? element::F_ESCAPED_NAME : 0))
+                                  : (element::F_BORROWED_STR | (has_escapes ? element::F_ESCAPED_STR : 0));
+        } else if (ctx.insitu && !ctx.is_repaired(raw)) {
+            // the decoded string never grows, so we can decode it in place and terminate it
+            // on top of the closing quote
+            out = const_cast<char*>(raw);
+            if (has_escapes) {
+                len = unescape_string(out, len, out);
+            }
+            out[len] = 0;
+            flags = property_name ? element::F_BORROWED_NAME : element::F_BORROWED_STR;
+        } else if (has_escapes) {
+            // decode into a scratch buffer first, so the final allocation has the exact size
+            thread_local std::string scratch;
+            scratch.resize(len);
+            len = unescape_string(raw, len, scratch.data());
+            out = item->new_string(scratch.data(), len);
+        } else {
+            out = item->new_string(raw, len);
+        }
+
+        item->m_flags |= flags;
+        if (property_name) {
+            item->m_property_name = out;
+            item->m_property_name_len = len;
+        } else {
+            item->m_value.str = out;
+            item->m_str_len = len;
+            item->m_kind = element_kind::T_STRING;
+        }
+    }
+
+    FLATTEN_INLINE bool null_value()
+    {
+        count_node(element_kind::T_NULL);
+        next()->m_kind = element_kind::T_NULL;
+        return true;
+    }
+    FLATTEN_INLINE bool bool_value(bool value)
+    {
+        element* item = next();
+        item->m_kind = value ? element_kind::T_TRUE : element_kind::T_FALSE;
+        count_node(item->m_kind);
+        return true;
+    }
+    FLATTEN_INLINE bool int64_value(int64_t value)
+    {
+        element* item = next();
+        item->set_int_value(value);
+        count_node(item->m_kind);
+        return true;
+    }
+    FLATTEN_INLINE bool uint64_value(uint64_t value)
+    {
+        element* item = next();
+        item->set_uint_value(value);
+        count_node(item->m_kind);
+        return true;
+    }
+    FLATTEN_INLINE bool double_value(double value)
+    {
+        count_node(element_kind::T_NUMBER);
+        element* item = next();
+        item->m_kind = element_kind::T_NUMBER;
+        item->m_value.number = value;
+        return true;
+    }
+    FLATTEN_INLINE bool string_value(const char* raw, size_t len, bool has_escapes)
+    {
+        count_node(element_kind::T_STRING);
+        store_string(next(), raw, len, has_escapes, false);
+        return true;
+    }
+    FLATTEN_INLINE bool key(const char* raw, size_t len, bool has_escapes)
+    {
+        member = append_child();
+        store_string(member, raw, len, has_escapes, true);
+        return true;
+    }
+    FLATTEN_INLINE bool start_object()
+    {
+        count_node(element_kind::T_OBJECT);
+        element* item = next();
+        item->m_kind = element_kind::T_OBJECT;
+        stack.push_back(parent);
+        parent = item;
+        count_depth();
+        return true;
+    }
+    FLATTEN_INLINE bool end_object()
+    {
+        parent = stack.back();
+        stack.pop_back();
+        return true;
+    }
+    FLATTEN_INLINE bool start_array()
+    {
+        count_node(element_kind::T_ARRAY);
+        element* item = next();
+        item->m_kind = element_kind::T_ARRAY;
+        stack.push_back(parent);
+        parent = item;
+        count_depth();
+        return true;
+    }
+    FLATTEN_INLINE bool end_array()
+    {
+        parent = stack.back();
+        stack.pop_back();
+        return true;
+    }
+};
+
+/// the `reader` handler of lazy parsing: builds the tree like `dom_builder`, but keeps the nested arrays and
+/// objects as raw text (see `element::F_LAZY`)
+struct lazy_builder : dom_builder {
+    using dom_builder::dom_builder;
+
+    /// when set, the array or object at the root of the input is parsed and only its children are kept as text
+    bool expand_root = false;
+
+    FLATTEN_INLINE bool deferred_container(const char* raw, size_t len, bool is_object)
+    {
+        count_node(is_object ? element_kind::T_OBJECT : element_kind::T_ARRAY);
+        element* item = next();
+        item->m_kind = is_object ? element_kind::T_OBJECT : element_kind::T_ARRAY;
+        item->m_flags |= element::F_LAZY;
+        item->m_value.str = const_cast<char*>(raw);
+        item->m_str_len = len;
+        return true;
+    }
+};
+
+void element::expand_lazy()
+{
+    parse_context ctx;
+    ctx.begin = m_value.str;
+    ctx.end = m_value.str + m_str_len;
+    ctx.view = true;
+    m_flags &= ~F_LAZY;
+    m_value.str = nullptr;
+    m_str_len = 0;
+
+    lazy_builder builder(ctx, this);
+    builder.expand_root = true;
+    if (!read(ctx, builder)) {
+        m_kind = element_kind::T_INVALID;
+        m_children.clear();
+        m_key_index.clear();
+    }
+}
+
+size_t element::find_child(std::string_view name) const
+{
+    expand_if_lazy();
+    if (m_children.size() < KEY_INDEX_MIN_SIZE) {
+        return scan_children(name);
+    }
+    return find_indexed_child(name, hash_property_name(name));
+}
+
+size_t element::find_child(const property_key& key) const
+{
+    expand_if_lazy();
+    if (m_children.size() < KEY_INDEX_MIN_SIZE) {
+        return scan_children(key.name());
+    }
+    return find_indexed_child(key.name(), key.hash());
+}
+
+size_t element::scan_children(std::string_view name) const
+{
+    size_t count = m_children.size();
+    for (size_t i = 0; i < count; ++i) {
+        const element& child = m_children[i];
+        if (child.has_property_name() && child.property_name_view() == name) {
+            return i;
+        }
+    }
+    return count;
+}
+
+size_t element::find_indexed_child(std::string_view name, uint32_t hash) const
+{
+    if (m_key_index.empty()) {
+        // need to index it first
+        const_cast<element*>(this)->build_key_index();
+    }
+
+    size_t count = m_children.size();
+    size_t mask = m_key_index.size() - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        const key_slot& entry = m_key_index[slot];
+        if (entry.position == 0) {
+            return count;
+        }
+        if (entry.hash == hash && m_children[entry.position - 1].property_name_view() == name) {
+            return entry.position - 1;
+        }
+    }
+}
+
+void element::build_key_index()
+{
+    // keep the load factor at or below 1/2, so the probe sequences stay short and always reach a free slot
+    size_t capacity = 16;
+    while (capacity < m_children.size() * 2) {
+        capacity *= 2;
+    }
+    m_key_index.assign(capacity, key_slot{ 0, 0 });
+
+    // inserting in order keeps the first of duplicate names first in its probe sequence
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < m_children.size(); ++i) {
+        element& child = m_children[i];
+        if (!child.has_property_name()) {
+            continue;
+        }
+        uint32_t hash = hash_property_name(child.property_name_view());
+        size_t slot = hash & mask;
+        while (m_key_index[slot].position != 0) {
+            slot = (slot + 1) & mask;
+        }
+        m_key_index[slot] = key_slot{ hash, static_cast<uint32_t>(i + 1) };
+    }
+}
+
+void element::index_child(size_t position)
+{
+    if (m_key_index.empty() || !m_children[position].has_property_name()) {
+        return;
+    }
+    if (m_children.size() * 2 > m_key_index.size()) {
+        // the new child is picked up by the rebuild
+        build_key_index();
+        return;
+    }
+
+    uint32_t hash = hash_property_name(m_children[position].property_name_view());
+    size_t mask = m_key_index.size() - 1;
+    size_t slot = hash & mask;
+    while (m_key_index[slot].position != 0) {
+        slot = (slot + 1) & mask;
+    }
+    m_key_index[slot] = key_slot{ hash, static_cast<uint32_t>(position + 1) };
+}
+
+bool element::create_array(element* arr)
+{
+    arr->m_kind = element_kind::T_ARRAY;
+    return true;
+}
+
+bool element::create_object(element* obj)
+{
+    obj->m_kind = element_kind::T_OBJECT;
+    return true;
+}
+
+parse_result element::parse_root(parse_context& ctx, element* root)
+{
+    TINYJSON_STAT(stats_timer timer{ current_stats.parse_ns });
+    TINYJSON_STAT(current_stats.bytes_parsed += ctx.end - ctx.begin);
+    thread_local std::vector<uint32_t> index;
+    attach_structural_index(ctx, index);
+
+    dom_builder builder(ctx, root);
+    parse_result result = read(ctx, builder);
+    release_structural_index(index);
+    return result;
+}
+
+parse_result element::parse(std::string_view content, element* root)
+{
+    parse_context ctx;
+    ctx.begin = content.data();
+    ctx.end = content.data() + content.length();
+    return parse_root(ctx, root);
+}
+
+parse_result element::parse_view(std::string_view content, element* root)
+{
+    parse_context ctx;
+    ctx.begin = content.data();
+    ctx.end = content.data() + content.length();
+    ctx.view = true;
+    return parse_root(ctx, root);
+}
+
+parse_result element::parse_lazy(std::string_view content, element* root)
+{
+    parse_context ctx;
+    ctx.begin = content.data();
+    ctx.end = content.data() + content.length();
+    ctx.view = true;
+    TINYJSON_STAT(stats_timer timer{ current_stats.parse_ns });
+    TINYJSON_STAT(current_stats.bytes_parsed += content.length());
+    // no structural index: most of the input is only skipped over
+    lazy_builder builder(ctx, root);
+    return read(ctx, builder);
+}
+
+parse_result element::parse_insitu(char* buffer, size_t length, element* root)
+{
+    parse_context ctx;
+    ctx.begin = buffer;
+    ctx.end = buffer + length;
+    ctx.insitu = true;
+    return parse_root(ctx, root);
+}
+
+parse_result element::parse_file(const std::string& path, element* root)
+{
+    mapped_file file;
+    if (!file.open(path)) {
+        return { parse_error::FILE_ERROR };
+    }
+
+    parse_context ctx;
+    ctx.begin = file.view().data();
+    ctx.end = file.view().data() + file.view().length();
+    parse_result result = parse_root(ctx, root);
+    // locate the failure while the file is still mapped
+    result.line();
+    return result;
+}
+
+mapped_file::~mapped_file() { close(); }
+
+bool mapped_file::open(const std::string& path)
+{
+    close();
+#if TINYJSON_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size == 0) {
+        // nothing to map
+        ::close(fd);
+        return true;
+    }
+
+    void* addr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after closing the descriptor
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        m_size = 0;
+        return false;
+    }
+    // the parser reads the file front to back, let the kernel read ahead aggressively
+    madvise(addr, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char*>(addr);
+    m_mapped = true;
+    return true;
+#else
+    FILE* file = fopen(path.c_str(), "rb");
+    // Check if there was an error.
+    if (file == nullptr) {
+        return false;
+    }
+
+    // Get the file length
+    fseek(file, 0, SEEK_END);
+    auto length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    m_buffer.resize(length);
+    size_t bytes = fread(m_buffer.data(), sizeof(char), length, file);
+
+    // no need for the file pointer any more, close it
+    fclose(file);
+
+    // did we read all the file?
+    if (bytes != static_cast<size_t>(length)) {
+        m_buffer.clear();
+        return false;
+    }
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    return true;
+#endif
+}
+
+void mapped_file::close()
+{
+#if TINYJSON_MMAP
+    if (m_mapped) {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+}
+
+namespace
+{
+/// the text is handed to the sink once the buffer grows beyond this size
+constexpr size_t SINK_CHUNK_SIZE = 64 * 1024;
+
+/// serializes an element tree by appending straight into a string. When a sink is set, the string is a
+/// reusable chunk buffer which is flushed every `SINK_CHUNK_SIZE` bytes
+struct writer {
+    std::string* out = nullptr;
+    const std::function<void(std::string_view)>* sink = nullptr;
+    bool pretty = true;
+
+    FLATTEN_INLINE void append(const char* str, size_t len) { out->append(str, len); }
+    FLATTEN_INLINE void append(std::string_view str) { out->append(str.data(), str.length()); }
+
+    FLATTEN_INLINE void indent(int depth)
+    {
+        static const char SPACES[] = "                                                                ";
+        constexpr int SPACES_COUNT = sizeof(SPACES) - 1;
+        if (!pretty) {
+            return;
+        }
+        for (; depth > SPACES_COUNT; depth -= SPACES_COUNT) {
+            append(SPACES, SPACES_COUNT);
+        }
+        append(SPACES, depth);
+    }
+
+    FLATTEN_INLINE void suffix(bool is_last)
+    {
+        if (is_last) {
+            if (pretty) {
+                out->push_back('\n');
+            }
+        } else {
+            append(pretty ? std::string_view(",\n") : std::string_view(","));
+        }
+    }
+
+    FLATTEN_INLINE void flush_if_needed()
+    {
+        if (sink && out->size() >= SINK_CHUNK_SIZE) {
+            flush();
+        }
+    }
+
+    void flush()
+    {
+        if (sink && !out->empty()) {
+            TINYJSON_STAT(current_stats.bytes_serialized += out->size());
+            (*sink)(std::string_view(*out));
+            out->clear();
+        }
+    }
+
+    /// `Element` is either `element` or `tape_element`
+    template <typename Element> void write(const Element& elem, int depth, bool last_child)
+    {
+        indent(depth);
+        if (elem.has_property_name()) {
+            std::string_view name = elem.property_name_view();
+            append_escaped(out, name.data(), name.length());
+            append(pretty ? std::string_view(": ") : std::string_view(":"));
+        }
+
+        switch (elem.kind()) {
+        case element_kind::T_STRING: {
+            std::string_view sv;
+            elem.as_str(&sv);
+            append_escaped(out, sv.data(), sv.length());
+        } break;
+        case element_kind::T_NUMBER: {
+            double d = 0.0;
+            elem.as_number(&d);
+            append_json_number(d, out);
+        } break;
+        case element_kind::T_INT64: {
+            char buffer[24];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), elem.to_int64());
+            append(buffer, result.ptr - buffer);
+        } break;
+        case element_kind::T_UINT64: {
+            char buffer[24];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), elem.to_uint64());
+            append(buffer, result.ptr - buffer);
+        } break;
+        case element_kind::T_TRUE:
+            append("true", 4);
+            break;
+        case element_kind::T_FALSE:
+            append("false", 5);
+            break;
+        case element_kind::T_NULL:
+            append("null", 4);
+            break;
+        case element_kind::T_OBJECT:
+        case element_kind::T_ARRAY: {
+            bool is_object = elem.kind() == element_kind::T_OBJECT;
+            size_t count = elem.size();
+            if (count == 0) {
+                append(is_object ? "{}" : "[]", 2);
+                break;
+            }
+            out->push_back(is_object ? '{' : '[');
+            if (pretty) {
+                out->push_back('\n');
+            }
+            for (size_t i = 0; i < count; ++i) {
+                write(elem[i], depth + 1, i == count - 1);
+                flush_if_needed();
+            }
+            indent(depth);
+            out->push_back(is_object ? '}' : ']');
+        } break;
+        case element_kind::T_INVALID:
+            return;
+        }
+        suffix(last_child);
+    }
+};
+} // namespace
+
+void element::to_string(std::ostream& ss, int depth, bool last_child, bool pretty) const
+{
+    TINYJSON_STAT(stats_timer timer{ current_stats.serialize_ns });
+    std::string buffer;
+    std::function<void(std::string_view)> sink = [&ss](std::string_view chunk) {
+        ss.write(chunk.data(), chunk.length());
+    };
+    writer w;
+    w.out = &buffer;
+    w.sink = &sink;
+    w.pretty = pretty;
+    w.write(*this, depth, last_child);
+    w.flush();
+}
+
+void to_string(const element& root, std::string* out, bool pretty)
+{
+    TINYJSON_STAT(stats_timer timer{ current_stats.serialize_ns });
+    TINYJSON_STAT(size_t start_size = out->size());
+    writer w;
+    w.out = out;
+    w.pretty = pretty;
+    w.write(root, 0, true);
+    TINYJSON_STAT(current_stats.bytes_serialized += out->size() - start_size);
+}
+
+void to_string(const tape_element& root, std::string* out, bool pretty)
+{
+    TINYJSON_STAT(stats_timer timer{ current_stats.serialize_ns });
+    TINYJSON_STAT(size_t start_size = out->size());
+    writer w;
+    w.out = out;
+    w.pretty = pretty;
+    w.write(root, 0, true);
+    TINYJSON_STAT(current_stats.bytes_serialized += out->size() - start_size);
+}
+
+void to_string(const element& root, const std::function<void(std::string_view)>& sink, bool pretty)
+{
+    TINYJSON_STAT(stats_timer timer{ current_stats.serialize_ns });
+    std::string buffer;
+    buffer.reserve(SINK_CHUNK_SIZE + SINK_CHUNK_SIZE / 4);
+    writer w;
+    w.out = &buffer;
+    w.sink = &sink;
+    w.pretty = pretty;
+    w.write(root, 0, true);
+    w.flush();
+}
+
+parse_result parse(std::string_view content, handler* h)
+{
+    parse_context ctx;
+    ctx.begin = content.data();
+    ctx.end = content.data() + content.length();
+    // not thread_local: the callbacks may start another parse
+    std::vector<uint32_t> index;
+    attach_structural_index(ctx, index);
+
+    sax_adapter adapter;
+    adapter.h = h;
+    return read(ctx, adapter);
+}
+
+parse_result parse(std::string_view content, bind_target root)
+{
+    parse_context ctx;
+    ctx.begin = content.data();
+    ctx.end = content.data() + content.length();
+    thread_local std::vector<uint32_t> index;
+    attach_structural_index(ctx, index);
+
+    bind_builder builder;
+    builder.root = root;
+    parse_result result = read(ctx, builder);
+    release_structural_index(index);
+    return result;
+}
+
+namespace
+{
+/// the parallel NDJSON reader hands about this many bytes of records to a worker at a time
+constexpr size_t NDJSON_BATCH_SIZE = 1024 * 1024;
+
+/// call `func` with every non blank line of `content`, stop when it returns false
+template <typename Func> bool for_each_line(std::string_view content, Func&& func)
+{
+    const char* p = content.data();
+    const char* end = content.data() + content.length();
+    while (p < end) {
+        const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+        const char* line_end = eol ? eol : end;
+        if (skip(p, line_end) != line_end && !func(std::string_view(p, line_end - p))) {
+            return false;
+        }
+        p = eol ? eol + 1 : end;
+    }
+    return true;
+}
+
+/// move the failure `result` of parsing `line`, a line of `content`, to an offset in `content`
+parse_result ndjson_failure(std::string_view content, std::string_view line, const parse_result& result)
+{
+    return { result.error, static_cast<size_t>(line.data() - content.data()) + result.offset, content.data() };
+}
+
+/// the failure of a callback that stopped at the record `record` (counted from 0) of `batch`, a part of `content`
+parse_result ndjson_stopped(std::string_view content, std::string_view batch, size_t record)
+{
+    const char* start = batch.data();
+    for_each_line(batch, [&](std::string_view line) {
+        start = line.data();
+        return record-- > 0;
+    });
+    return { parse_error::STOPPED, static_cast<size_t>(start - content.data()), content.data() };
+}
+
+/// the records of a batch of lines, parsed by one of the workers
+struct ndjson_batch {
+    std::pmr::monotonic_buffer_resource arena;
+    std::vector<element> records;
+    /// fails if the last record is malformed, with its offset in the whole input
+    parse_result result;
+};
+
+parse_result parse_ndjson_parallel(std::string_view content, const ndjson_callback& callback, size_t threads)
+{
+    // split the input into batches at line boundaries
+    std::vector<std::string_view> batches;
+    const char* p = content.data();
+    const char* end = content.data() + content.length();
+    while (p < end) {
+        const char* split = end;
+        if (static_cast<size_t>(end - p) > NDJSON_BATCH_SIZE) {
+            const char* from = p + NDJSON_BATCH_SIZE;
+            const char* eol = static_cast<const char*>(memchr(from, '\n', end - from));
+            split = eol ? eol + 1 : end;
+        }
+        batches.emplace_back(p, split - p);
+        p = split;
+    }
+
+    // batch `i` is parsed into slot `i % slots.size()`. The workers parse ahead while the calling thread
+    // reports the parsed batches in order, a slot is reused once its batch was reported
+    std::vector<std::unique_ptr<ndjson_batch>> slots(threads * 2);
+    for (auto& slot : slots) {
+        slot.reset(new ndjson_batch());
+    }
+    // `ready[i % slots.size()] == i + 1` once batch `i` is parsed
+    std::vector<size_t> ready(slots.size(), 0);
+    size_t reported = 0;
+    bool stop = false;
+    std::atomic<size_t> next_batch{ 0 };
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    auto worker = [&]() {
+        for (;;) {
+            size_t i = next_batch.fetch_add(1);
+            if (i >= batches.size()) {
+                return;
+            }
+
+            ndjson_batch& batch = *slots[i % slots.size()];
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&]() { return stop || i < reported + slots.size(); });
+                if (stop) {
+                    return;
+                }
+            }
+
+            batch.records.clear();
+            batch.arena.release();
+            batch.result = {};
+            for_each_line(batches[i], [&](std::string_view line) {
+                batch.records.emplace_back(&batch.arena);
+                parse_result result = element::parse_view(line, &batch.records.back());
+                if (!result) {
+                    batch.result = ndjson_failure(content, line, result);
+                }
+                return result.ok();
+            });
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ready[i % slots.size()] = i + 1;
+            }
+            cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+
+    parse_result outcome;
+    size_t index = 0;
+    for (size_t i = 0; outcome && i < batches.size(); ++i) {
+        ndjson_batch& batch = *slots[i % slots.size()];
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&]() { return ready[i % slots.size()] == i + 1; });
+        }
+
+        // a malformed record is the last one of its batch
+        size_t count = batch.result ? batch.records.size() : batch.records.size() - 1;
+        for (size_t r = 0; outcome && r < count; ++r) {
+            if (!callback(index++, batch.records[r])) {
+                outcome = ndjson_stopped(content, batches[i], r);
+            }
+        }
+        if (outcome && !batch.result) {
+            outcome = batch.result;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            reported = i + 1;
+        }
+        cv.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cv.notify_all();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return outcome;
+}
+} // namespace
+
+parse_result parse_ndjson(std::string_view content, const ndjson_callback& callback, size_t threads)
+{
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (threads > 1 && content.length() > NDJSON_BATCH_SIZE) {
+        return parse_ndjson_parallel(content, callback, threads);
+    }
+
+    // a single document, rewound for every record
+    document doc;
+    size_t index = 0;
+    parse_result outcome;
+    for_each_line(content, [&](std::string_view line) {
+        parse_result result = doc.parse_view(line);
+        if (!result) {
+            outcome = ndjson_failure(content, line, result);
+        } else if (!callback(index++, doc.root())) {
+            outcome = { parse_error::STOPPED, static_cast<size_t>(line.data() - content.data()), content.data() };
+        }
+        return outcome.ok();
+    });
+    return outcome;
+}
+
+parse_result parse_ndjson_file(const std::string& path, const ndjson_callback& callback, size_t threads)
+{
+    mapped_file file;
+    if (!file.open(path)) {
+        return { parse_error::FILE_ERROR };
+    }
+    parse_result result = parse_ndjson(file.view(), callback, threads);
+    // locate the failure while the file is still mapped
+    result.line();
+    return result;
+}
+
+/// the state machine behind `push_parser`. It consumes the input byte by byte, except inside strings, numbers
+/// and literals which are scanned in one go. A token split between chunks is carried over in `token`
+struct push_state {
+    enum class state {
+        /// expecting a value
+        VALUE,
+        /// expecting the first value of an array, or `]`
+        ARRAY_FIRST,
+        /// expecting the first key of an object, or `}`
+        OBJECT_FIRST,
+        /// expecting a key (after `,`)
+        KEY,
+        /// expecting `:`
+        COLON,
+        /// expecting `,` or the end of the innermost array / object
+        AFTER_VALUE,
+        STRING,
+        NUMBER,
+        LITERAL,
+        /// the value is complete, only whitespace may follow
+        DONE,
+        FAILED,
+    };
+
+    /// strings are copied (and decoded) by the tree builder
+    parse_context ctx;
+    std::unique_ptr<dom_builder> dom;
+    sax_adapter sax;
+
+    state current = state::VALUE;
+    /// the open arrays and objects (`[` or `{`), innermost last
+    std::vector<char> containers;
+    /// the bytes fed so far, checked against `parse_limits::max_document_size`
+    size_t fed = 0;
+    /// the current chunk and the offset of its first byte in the whole input
+    const char* chunk = nullptr;
+    size_t chunk_offset = 0;
+    /// the current line (from 1) and the offset of its first byte, to locate the errors
+    size_t line = 1;
+    size_t line_offset = 0;
+    /// why and where the parse failed
+    parse_error error = parse_error::NONE;
+    size_t error_offset = 0;
+
+    /// the part of the current token received in the previous chunks
+    std::string token;
+    /// the first byte of the current token in the current chunk
+    const char* token_begin = nullptr;
+    /// the offset of the current token's first byte in the whole input
+    size_t token_offset = 0;
+    /// the current string is a key
+    bool is_key = false;
+    bool has_escapes = false;
+    /// the last byte of the current string's previous chunk was an (unescaped) backslash
+    bool escape_pending = false;
+
+    /// invoke `func` with the handler in use: the tree builder or the user's handler
+    template <typename Func> bool emit(Func&& func) { return dom ? func(*dom) : func(sax); }
+
+    /// the offset of `p`, a byte of the current chunk, in the whole input
+    FLATTEN_INLINE size_t offset_of(const char* p) const { return chunk_offset + (p - chunk); }
+
+    /// record why the parse failed at `offset`, only the first failure is kept
+    FLATTEN_INLINE bool fail(parse_error reason, size_t offset)
+    {
+        if (current != state::FAILED) {
+            error = reason;
+            error_offset = offset;
+        }
+        current = state::FAILED;
+        return false;
+    }
+
+    /// the outcome so far. The position is located right away, the chunks are not kept
+    parse_result result() const
+    {
+        parse_result outcome;
+        if (error != parse_error::NONE) {
+            outcome = parse_result(error, error_offset);
+            outcome.m_line = line;
+            outcome.m_column = error_offset - line_offset + 1;
+        }
+        return outcome;
+    }
+
+    FLATTEN_INLINE void value_done() { current = containers.empty() ? state::DONE : state::AFTER_VALUE; }
+
+    /// the current token, once its last byte (excluded) is `token_end`
+    FLATTEN_INLINE std::string_view complete_token(const char* token_end)
+    {
+        if (token.empty()) {
+            return { token_begin, static_cast<size_t>(token_end - token_begin) };
+        }
+        token.append(token_begin, token_end - token_begin);
+        return token;
+    }
+
+    FLATTEN_INLINE void start_token(const char* begin, state next)
+    {
+        token.clear();
+        token_begin = begin;
+        token_offset = offset_of(begin);
+        current = next;
+    }
+
+    bool start_value(const char* p);
+    bool end_container(const char* p);
+    const char* scan_string(const char* p, const char* end);
+    bool emit_number(std::string_view text);
+    /// `at_end` is set when `text` is the end of the input
+    bool emit_literal(std::string_view text, bool at_end = false);
+    bool feed(const char* data, size_t length);
+    bool finish();
+};
+
+/// return true for the bytes that may appear in a number
+FLATTEN_INLINE bool is_number_char(char c)
+{
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+bool push_state::start_value(const char* p)
+{
+    if (++ctx.elements > ctx.limits.max_elements) {
+        return fail(parse_error::TOO_MANY_ELEMENTS, offset_of(p));
+    }
+    char c = *p;
+    if (c == '"') {
+        is_key = false;
+        has_escapes = false;
+        escape_pending = false;
+        start_token(p + 1, state::STRING);
+        return true;
+    }
+    if (c == '-' || (c >= '0' && c <= '9')) {
+        start_token(p, state::NUMBER);
+        return true;
+    }
+    if (c >= 'a' && c <= 'z') {
+        start_token(p, state::LITERAL);
+        return true;
+    }
+    if ((c == '[' || c == '{') && containers.size() >= ctx.limits.max_depth) {
+        return fail(parse_error::TOO_DEEP, offset_of(p));
+    }
+    if (c == '[') {
+        containers.push_back('[');
+        current = state::ARRAY_FIRST;
+        return emit([](auto& h) { return h.start_array(); }) || fail(parse_error::STOPPED, offset_of(p));
+    }
+    if (c == '{') {
+        containers.push_back('{');
+        current = state::OBJECT_FIRST;
+        return emit([](auto& h) { return h.start_object(); }) || fail(parse_error::STOPPED, offset_of(p));
+    }
+    return fail(parse_error::UNEXPECTED_CHARACTER, offset_of(p));
+}
+
+bool push_state::end_container(const char* p)
+{
+    char closing = *p;
+    if (containers.back() != (closing == ']' ? '[' : '{')) {
+        return fail(parse_error::UNEXPECTED_CHARACTER, offset_of(p));
+    }
+    containers.pop_back();
+    value_done();
+    bool ok = closing == ']' ? emit([](auto& h) { return h.end_array(); })
+                             : emit([](auto& h) { return h.end_object(); });
+    return ok || fail(parse_error::STOPPED, offset_of(p));
+}
+
+/// scan the string from `p` up to its closing quote. Return the byte after the closing quote, or `end` if the
+/// string continues in the next chunk
+const char* push_state::scan_string(const char* p, const char* end)
+{
+    if (escape_pending) {
+        // the byte escaped by the backslash that ended the previous chunk
+        escape_pending = false;
+        ++p;
+    }
+    while (p < end && *p != '"') {
+        if (*p++ == '\\') {
+            has_escapes = true;
+            if (p == end) {
+                escape_pending = true;
+                break;
+            }
+            ++p;
+        }
+    }
+    // the opening quote
+    size_t string_offset = token_offset - 1;
+    if (p >= end) {
+        // the part received so far is kept until the string ends
+        if (token.size() + (end - token_begin) > ctx.limits.max_string_length) {
+            fail(parse_error::STRING_TOO_LONG, string_offset);
+        }
+        return end;
+    }
+
+    std::string_view raw = complete_token(p);
+    if (raw.length() > ctx.limits.max_string_length) {
+        fail(parse_error::STRING_TOO_LONG, string_offset);
+        return end;
+    }
+    if (has_escapes) {
+        const char* bad_escape = find_bad_escape(raw.data(), raw.data() + raw.length(), ctx.utf8 == utf8_mode::STRICT);
+        if (bad_escape) {
+            fail(parse_error::BAD_ESCAPE, token_offset + (bad_escape - raw.data()));
+            return end;
+        }
+    }
+    // the bytes outside of the strings are ASCII, or unexpected characters
+    const char* invalid = nullptr;
+    if (ctx.utf8 != utf8_mode::UNCHECKED) {
+        invalid = find_invalid_utf8(raw.data(), raw.data() + raw.length());
+    }
+    if (invalid && ctx.utf8 == utf8_mode::STRICT) {
+        fail(parse_error::INVALID_UTF8, token_offset + (invalid - raw.data()));
+        return end;
+    }
+    if (invalid) {
+        repair_utf8(raw.data(), raw.data() + raw.length(), &ctx.repaired);
+        raw = ctx.repaired;
+    }
+    bool ok = is_key ? emit([&](auto& h) { return h.key(raw.data(), raw.length(), has_escapes); })
+                     : emit([&](auto& h) { return h.string_value(raw.data(), raw.length(), has_escapes); });
+    if (!ok) {
+        fail(parse_error::STOPPED, string_offset);
+        return end;
+    }
+    if (is_key) {
+        current = state::COLON;
+    } else {
+        value_done();
+    }
+    return p + 1;
+}
+
+bool push_state::emit_number(std::string_view text)
+{
+    // the same conversion as the reader, which must consume the whole token
+    parse_error reason = parse_error::UNEXPECTED_CHARACTER;
+    size_t offset = token_offset;
+    bool ok = emit([&](auto& h) {
+        parse_context number_ctx;
+        number_ctx.begin = text.data();
+        number_ctx.end = text.data() + text.length();
+        reader<std::decay_t<decltype(h)>> r{ number_ctx, h };
+        const char* number_end = r.parse_number(text.data());
+        if (number_end) {
+            offset += number_end - text.data();
+        } else {
+            reason = number_ctx.error;
+            offset += number_ctx.failed_at - text.data();
+        }
+        return number_end == number_ctx.end;
+    });
+    if (!ok) {
+        // the token ends before the next byte of the input, if there is one
+        if (reason == parse_error::UNEXPECTED_END && offset < fed) {
+            reason = parse_error::UNEXPECTED_CHARACTER;
+        }
+        return fail(reason, offset);
+    }
+    value_done();
+    return true;
+}
+
+bool push_state::emit_literal(std::string_view text, bool at_end)
+{
+    bool ok = false;
+    if (text == "null") {
+        ok = emit([](auto& h) { return h.null_value(); });
+    } else if (text == "true" || text == "false") {
+        ok = emit([&](auto& h) { return h.bool_value(text[0] == 't'); });
+    } else {
+        // fail at the first byte that is not part of a literal, like the reader: after a complete literal at the
+        // top level, that byte is content after the value
+        size_t matched = literal_prefix_length(text);
+        std::string_view prefix = text.substr(0, matched);
+        bool complete = prefix == "null" || prefix == "true" || prefix == "false";
+        parse_error reason = parse_error::UNEXPECTED_CHARACTER;
+        if (complete && containers.empty()) {
+            reason = parse_error::TRAILING_CONTENT;
+        } else if (at_end && matched == text.length()) {
+            reason = parse_error::UNEXPECTED_END;
+        }
+        return fail(reason, token_offset + matched);
+    }
+    if (!ok) {
+        return fail(parse_error::STOPPED, token_offset);
+    }
+    value_done();
+    return true;
+}
+
+bool push_state::feed(const char* data, size_t length)
+{
+    const char* p = data;
+    const char* end = data + length;
+    chunk = data;
+    chunk_offset = fed;
+    fed += length;
+    if (fed > ctx.limits.max_document_size) {
+        return fail(parse_error::DOCUMENT_TOO_LARGE, ctx.limits.max_document_size);
+    }
+    // a token split between the previous chunk and this one continues here
+    token_begin = p;
+    while (p < end) {
+        switch (current) {
+        case state::STRING:
+            p = scan_string(p, end);
+            continue;
+        case state::NUMBER:
+        case state::LITERAL: {
+            bool is_number = current == state::NUMBER;
+            const char* token_end = p;
+            if (is_number) {
+                while (token_end < end && is_number_char(*token_end)) {
+                    ++token_end;
+                }
+            } else {
+                while (token_end < end && *token_end >= 'a' && *token_end <= 'z') {
+                    ++token_end;
+                }
+            }
+            if (token_end == end) {
+                p = end;
+                continue;
+            }
+            std::string_view text = complete_token(token_end);
+            if (!(is_number ? emit_number(text) : emit_literal(text))) {
+                return false;
+            }
+            p = token_end;
+            continue;
+        }
+        case state::FAILED:
+            return false;
+        default:
+            break;
+        }
+
+        // same definition of whitespace as `skip()`
+        unsigned char c = *p;
+        if (c <= 32 && c != 0) {
+            if (c == '\n') {
+                ++line;
+                line_offset = offset_of(p) + 1;
+            }
+            ++p;
+            continue;
+        }
+
+        switch (current) {
+        case state::VALUE:
+            start_value(p);
+            break;
+        case state::ARRAY_FIRST:
+            if (c == ']') {
+                end_container(p);
+            } else {
+                start_value(p);
+            }
+            break;
+        case state::OBJECT_FIRST:
+        case state::KEY:
+            if (c == '}' && current == state::OBJECT_FIRST) {
+                end_container(p);
+            } else if (c == '"') {
+                is_key = true;
+                has_escapes = false;
+                escape_pending = false;
+                start_token(p + 1, state::STRING);
+            } else {
+                fail(parse_error::UNEXPECTED_CHARACTER, offset_of(p));
+            }
+            break;
+        case state::COLON:
+            if (c == ':') {
+                current = state::VALUE;
+            } else {
+                fail(parse_error::UNEXPECTED_CHARACTER, offset_of(p));
+            }
+            break;
+        case state::AFTER_VALUE:
+            if (c == ',') {
+                current = containers.back() == '[' ? state::VALUE : state::KEY;
+            } else if (c == ']' || c == '}') {
+                end_container(p);
+            } else {
+                fail(parse_error::UNEXPECTED_CHARACTER, offset_of(p));
+            }
+            break;
+        default:
+            // only whitespace may follow the value
+            fail(parse_error::TRAILING_CONTENT, offset_of(p));
+            break;
+        }
+        ++p;
+    }
+
+    // keep the part of the current token received so far
+    if (current == state::STRING || current == state::NUMBER || current == state::LITERAL) {
+        token.append(token_begin, end - token_begin);
+    }
+    return current != state::FAILED;
+}
+
+bool push_state::finish()
+{
+    // a number or a literal at the top level ends with the input
+    if (current == state::NUMBER || current == state::LITERAL) {
+        std::string_view text = token;
+        if (!(current == state::NUMBER ? emit_number(text) : emit_literal(text, true))) {
+            return false;
+        }
+    }
+    if (current == state::STRING) {
+        return fail(parse_error::UNTERMINATED_STRING, token_offset - 1);
+    }
+    // an incomplete value
+    return current == state::DONE || fail(parse_error::UNEXPECTED_END, fed);
+}
+
+push_parser::push_parser(handler* h)
+    : m_state(new push_state())
+{
+    m_state->sax.h = h;
+}
+
+push_parser::push_parser(element* root)
+    : m_state(new push_state())
+{
+    m_state->dom.reset(new dom_builder(m_state->ctx, root));
+}
+
+push_parser::~push_parser() {}
+
+parse_result push_parser::feed(const char* data, size_t length)
+{
+    m_state->feed(data, length);
+    return m_state->result();
+}
+
+parse_result push_parser::finish()
+{
+    m_state->finish();
+    return m_state->result();
+}
+
+/// the `reader` handler that builds a `tape_document`. The direct children of the open arrays and objects are
+/// kept in `pending` and moved to the document (next to each other) when their parent ends
+struct tape_builder {
+    tape_document& doc;
+    /// the open arrays and objects and their children so far
+    std::vector<tape_node> pending;
+    /// the position in `pending` of every open array or object, innermost last
+    std::vector<size_t> containers;
+    /// the name of the next object member
+    uint32_t next_key = tape_node::NO_KEY;
+
+    explicit tape_builder(tape_document& document)
+        : doc(document)
+    {
+    }
+
+    FLATTEN_INLINE tape_node& push(element_kind kind)
+    {
+        pending.emplace_back();
+        tape_node& node = pending.back();
+        node.kind = kind;
+        node.key = next_key;
+        next_key = tape_node::NO_KEY;
+        return node;
+    }
+
+    /// append the decoded string to the pool and return its offset. Return false if the pool grows beyond
+    /// the 32 bit offsets
+    FLATTEN_INLINE bool append_string(const char* raw, size_t len, bool has_escapes, size_t* length)
+    {
+        std::string& pool = doc.m_strings;
+        size_t offset = pool.size();
+        if (has_escapes) {
+            pool.resize(offset + len);
+            len = unescape_string(raw, len, &pool[offset]);
+            pool.resize(offset + len);
+        } else {
+            pool.append(raw, len);
+        }
+        *length = len;
+        return pool.size() <= UINT32_MAX;
+    }
+
+    FLATTEN_INLINE bool null_value()
+    {
+        push(element_kind::T_NULL);
+        return true;
+    }
+    FLATTEN_INLINE bool bool_value(bool value)
+    {
+        push(value ? element_kind::T_TRUE : element_kind::T_FALSE).value.boolean = value;
+        return true;
+    }
+    FLATTEN_INLINE bool int64_value(int64_t value)
+    {
+        push(element_kind::T_INT64).value.int64 = value;
+        return true;
+    }
+    FLATTEN_INLINE bool uint64_value(uint64_t value)
+    {
+        push(element_kind::T_UINT64).value.uint64 = value;
+        return true;
+    }
+    FLATTEN_INLINE bool double_value(double value)
+    {
+        push(element_kind::T_NUMBER).value.number = value;
+        return true;
+    }
+    FLATTEN_INLINE bool string_value(const char* raw, size_t len, bool has_escapes)
+    {
+        size_t offset = doc.m_strings.size();
+        if (!append_string(raw, len, has_escapes, &len)) {
+            return false;
+        }
+        tape_node& node = push(element_kind::T_STRING);
+        node.range.offset = static_cast<uint32_t>(offset);
+        node.range.length = static_cast<uint32_t>(len);
+        return true;
+    }
+    FLATTEN_INLINE bool key(const char* raw, size_t len, bool has_escapes)
+    {
+        // the name is stored after its length
+        std::string& pool = doc.m_strings;
+        size_t offset = pool.size();
+        uint32_t length = 0;
+        pool.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        if (!append_string(raw, len, has_escapes, &len)) {
+            return false;
+        }
+        length = static_cast<uint32_t>(len);
+        memcpy(&pool[offset], &length, sizeof(length));
+        next_key = static_cast<uint32_t>(offset);
+        return true;
+    }
+    FLATTEN_INLINE bool start_container(element_kind kind)
+    {
+        push(kind);
+        containers.push_back(pending.size() - 1);
+        return true;
+    }
+    FLATTEN_INLINE bool end_container()
+    {
+        size_t at = containers.back();
+        containers.pop_back();
+        size_t first_child = at + 1;
+        size_t count = pending.size() - first_child;
+        size_t offset = doc.m_nodes.size();
+        if (offset + count > UINT32_MAX) {
+            return false;
+        }
+        doc.m_nodes.insert(doc.m_nodes.end(), pending.begin() + first_child, pending.end());
+        pending.resize(first_child);
+        pending[at].range.offset = static_cast<uint32_t>(offset);
+        pending[at].range.length = static_cast<uint32_t>(count);
+        return true;
+    }
+    FLATTEN_INLINE bool start_object() { return start_container(element_kind::T_OBJECT); }
+    FLATTEN_INLINE bool end_object() { return end_container(); }
+    FLATTEN_INLINE bool start_array() { return start_container(element_kind::T_ARRAY); }
+    FLATTEN_INLINE bool end_array() { return end_container(); }
+};
+
+parse_result tape_document::parse(std::string_view content)
+{
+    m_nodes.clear();
+    m_strings.clear();
+    // the root is the first node
+    m_nodes.emplace_back();
+
+    parse_context ctx;
+    ctx.begin = content.data();
+    ctx.end = content.data() + content.length();
+    thread_local std::vector<uint32_t> index;
+    attach_structural_index(ctx, index);
+
+    tape_builder builder(*this);
+    parse_result result = read(ctx, builder);
+    release_structural_index(index);
+    if (result && builder.pending.size() != 1) {
+        result = parse_result(parse_error::UNEXPECTED_END, content.length(), content.data());
+    }
+    if (!result) {
+        m_nodes.clear();
+        m_strings.clear();
+        return result;
+    }
+    m_nodes[0] = builder.pending[0];
+    return result;
+}
+
+tape_element tape_document::root() const
+{
+    return m_nodes.empty() ? tape_element() : tape_element(this, m_nodes.data());
+}
+
+tape_element::iterator tape_element::begin() const
+{
+    return iterator(m_doc, size() ? m_doc->m_nodes.data() + m_node->range.offset : nullptr);
+}
+
+tape_element::iterator tape_element::end() const
+{
+    return iterator(m_doc, size() ? m_doc->m_nodes.data() + m_node->range.offset + m_node->range.length : nullptr);
+}
+
+tape_element tape_element::operator[](size_t index) const
+{
+    if (index >= size()) {
+        return tape_element();
+    }
+    return tape_element(m_doc, m_doc->m_nodes.data() + m_node->range.offset + index);
+}
+
+tape_element tape_element::operator[](std::string_view name) const
+{
+    if (!is_object()) {
+        return tape_element();
+    }
+    for (tape_element child : *this) {
+        if (child.property_name_view() == name) {
+            return child;
+        }
+    }
+    return tape_element();
+}
+
+std::string_view tape_element::property_name_view() const
+{
+    if (!has_property_name()) {
+        return {};
+    }
+    const char* name = m_doc->m_strings.data() + m_node->key;
+    uint32_t length = 0;
+    memcpy(&length, name, sizeof(length));
+    return { name + sizeof(length), length };
+}
+
+std::string_view tape_element::str_view() const
+{
+    return { m_doc->m_strings.data() + m_node->range.offset, m_node->range.length };
+}
+
+thread_local element null_element;
+
+namespace
+{
+/// parse the decimal number at the start of `text`. Return the number of digits read (0 if there is none or if
+/// it overflows)
+size_t parse_index(std::string_view text, size_t* value)
+{
+    auto result = std::from_chars(text.data(), text.data() + text.length(), *value);
+    if (result.ec != std::errc()) {
+        return 0;
+    }
+    return result.ptr - text.data();
+}
+} // namespace
+
+bool query::finish_compile()
+{
+    m_single = true;
+    for (auto& s : m_steps) {
+        s.hash = hash_property_name(s.name);
+        // at most one item selected
+        bool single_item = s.last <= s.first || (s.last - s.first - 1) / s.stride == 0;
+        m_single = m_single && !s.all_members && single_item;
+    }
+    m_valid = true;
+    return true;
+}
+
+bool query::compile_pointer(std::string_view pointer)
+{
+    m_steps.clear();
+    m_valid = false;
+    if (!pointer.empty() && pointer[0] != '/') {
+        return false;
+    }
+
+    size_t pos = 0;
+    while (pos < pointer.length()) {
+        size_t token_end = pointer.find('/', pos + 1);
+        if (token_end == std::string_view::npos) {
+            token_end = pointer.length();
+        }
+        std::string_view token = pointer.substr(pos + 1, token_end - pos - 1);
+        pos = token_end;
+
+        step s;
+        s.by_name = true;
+        s.name.reserve(token.length());
+        for (size_t i = 0; i < token.length(); ++i) {
+            if (token[i] != '~') {
+                s.name.push_back(token[i]);
+                continue;
+            }
+            if (i + 1 == token.length() || (token[i + 1] != '0' && token[i + 1] != '1')) {
+                return false;
+            }
+            s.name.push_back(token[++i] == '0' ? '~' : '/');
+        }
+
+        // the token is also an array index when it is a number without leading zeros
+        size_t index = 0;
+        if (!token.empty() && (token.length() == 1 || token[0] != '0') && parse_index(token, &index) == token.length() &&
+            index != SIZE_MAX) {
+            s.first = index;
+            s.last = index + 1;
+        }
+        m_steps.push_back(std::move(s));
+    }
+    return finish_compile();
+}
+
+bool query::compile(std::string_view path)
+{
+    m_steps.clear();
+    m_valid = false;
+
+    size_t pos = 0;
+    if (!path.empty() && path[0] == '$') {
+        ++pos;
+    }
+
+    // the end of a name written without quotes
+    auto name_end = [&](size_t start) {
+        size_t end = path.find_first_of(".[", start);
+        return end == std::string_view::npos ? path.length() : end;
+    };
+
+    while (pos < path.length()) {
+        step s;
+        if (path[pos] == '.' || pos == 0) {
+            // `.name`, `.*`, or a name at the very start
+            if (path[pos] == '.') {
+                ++pos;
+            }
+            if (pos < path.length() && path[pos] == '*') {
+                s.all_members = true;
+                s.last = SIZE_MAX;
+                ++pos;
+            } else {
+                size_t end = name_end(pos);
+                if (end == pos) {
+                    return false;
+                }
+                s.by_name = true;
+                s.name.assign(path.data() + pos, end - pos);
+                pos = end;
+            }
+            m_steps.push_back(std::move(s));
+            continue;
+        }
+
+        if (path[pos] != '[' || ++pos == path.length()) {
+            return false;
+        }
+
+        char c = path[pos];
+        if (c == '\'' || c == '\"') {
+            // `['name']`, a backslash escapes the next character
+            s.by_name = true;
+            for (++pos; pos < path.length() && path[pos] != c; ++pos) {
+                if (path[pos] == '\\' && pos + 1 < path.length()) {
+                    ++pos;
+                }
+                s.name.push_back(path[pos]);
+            }
+            if (pos == path.length()) {
+                return false;
+            }
+            ++pos;
+        } else if (c == '*') {
+            s.all_members = true;
+            s.last = SIZE_MAX;
+            ++pos;
+        } else {
+            // `[index]` or `[start:end:step]`
+            size_t value = 0;
+            size_t digits = parse_index(path.substr(pos), &value);
+            pos += digits;
+            if (pos < path.length() && path[pos] == ']') {
+                if (!digits || value == SIZE_MAX) {
+                    return false;
+                }
+                s.first = value;
+                s.last = value + 1;
+            } else {
+                s.first = digits ? value : 0;
+                s.last = SIZE_MAX;
+                for (size_t* part : { &s.last, &s.stride }) {
+                    if (pos == path.length() || path[pos] != ':') {
+                        break;
+                    }
+                    ++pos;
+                    digits = parse_index(path.substr(pos), &value);
+                    pos += digits;
+                    if (digits) {
+                        *part = value;
+                    }
+                }
+                if (s.stride == 0) {
+                    return false;
+                }
+            }
+        }
+
+        if (pos == path.length() || path[pos] != ']') {
+            return false;
+        }
+        ++pos;
+        m_steps.push_back(std::move(s));
+    }
+    return finish_compile();
+}
+
+namespace
+{
+/// the member of `value` selected by a `query::step` with a name
+FLATTEN_INLINE const element& query_member(const element& value, const query::step& s) { return value[s.key()]; }
+FLATTEN_INLINE tape_element query_member(const tape_element& value, const query::step& s)
+{
+    return value[std::string_view(s.name)];
+}
+} // namespace
+
+template <typename Element, typename Output>
+bool query::collect(const Element& value, size_t depth, Output&& output) const
+{
+    if (depth == m_steps.size()) {
+        return output(value);
+    }
+
+    const step& s = m_steps[depth];
+    if (value.is_object()) {
+        if (s.all_members) {
+            for (const auto& child : value) {
+                if (!collect(child, depth + 1, output)) {
+                    return false;
+                }
+            }
+        } else if (s.by_name) {
+            const auto& child = query_member(value, s);
+            if (child.is_ok()) {
+                return collect(child, depth + 1, output);
+            }
+        }
+    } else if (value.is_array()) {
+        size_t count = std::min(value.size(), s.last);
+        for (size_t i = s.first; i < count; i += s.stride) {
+            if (!collect(value[i], depth + 1, output)) {
+                return false;
+            }
+            if (s.stride > count - i) {
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+void query::select(const element& root, std::vector<const element*>* matches) const
+{
+    if (!m_valid) {
+        return;
+    }
+    collect(root, 0, [matches](const element& match) {
+        matches->push_back(&match);
+        return true;
+    });
+}
+
+void query::select(const tape_element& root, std::vector<tape_element>* matches) const
+{
+    if (!m_valid) {
+        return;
+    }
+    collect(root, 0, [matches](const tape_element& match) {
+        matches->push_back(match);
+        return true;
+    });
+}
+
+const element& query::first(const element& root) const
+{
+    const element* found = nullptr;
+    if (m_valid) {
+        collect(root, 0, [&found](const element& match) {
+            found = &match;
+            return false;
+        });
+    }
+    return found ? *found : null_element;
+}
+
+tape_element query::first(const tape_element& root) const
+{
+    tape_element found;
+    if (m_valid) {
+        collect(root, 0, [&found](const tape_element& match) {
+            found = match;
+            return false;
+        });
+    }
+    return found;
+}
+
+namespace
+{
+/// the `reader` handler behind `query::select(content, callback)`. It only enters the arrays and objects on the
+/// path of the query and skips the others. The matched values are built with a `dom_builder`
+struct query_matcher {
+    /// an open array or object on the path of the query
+    struct frame {
+        bool is_array = false;
+        /// the position of the next item, for arrays
+        size_t next_item = 0;
+    };
+
+    parse_context& ctx;
+    const std::vector<query::step>& steps;
+    const query_callback& callback;
+    bool single = false;
+    /// the open arrays and objects on the path, innermost last. The values inside `path.back()` are selected by
+    /// `steps[path.size() - 1]`
+    std::vector<frame> path;
+    /// the name of the member whose value comes next is selected
+    bool member_selected = false;
+    /// the matched value being built, and its builder
+    std::optional<element> match;
+    std::optional<dom_builder> builder;
+    /// the arrays and objects open inside the matched value
+    size_t match_depth = 0;
+    /// set when the single match of the query was found, the parse is then stopped early
+    bool done = false;
+    /// the decoded member names
+    std::string scratch;
+
+    query_matcher(parse_context& context, const query& q, const query_callback& on_match)
+        : ctx(context)
+        , steps(q.steps())
+        , callback(on_match)
+        , single(q.is_single())
+    {
+    }
+
+    /// return true if the value that starts now is selected by its step
+    FLATTEN_INLINE bool selected()
+    {
+        if (path.empty()) {
+            return true;
+        }
+        frame& parent = path.back();
+        if (parent.is_array) {
+            return steps[path.size() - 1].selects_item(parent.next_item++);
+        }
+        bool result = member_selected;
+        member_selected = false;
+        return result;
+    }
+
+    void begin_match()
+    {
+        match.emplace();
+        builder.emplace(ctx, &*match);
+    }
+
+    bool end_match()
+    {
+        builder.reset();
+        bool ok = callback(*match);
+        match.reset();
+        if (ok && single) {
+            done = true;
+            return false;
+        }
+        return ok;
+    }
+
+    /// report a number, a string or a literal through `build(dom_builder&)`
+    template <typename Build> bool scalar(Build&& build)
+    {
+        if (builder) {
+            return build(*builder);
+        }
+        if (!selected() || path.size() != steps.size()) {
+            return true;
+        }
+        begin_match();
+        return build(*builder) && end_match();
+    }
+
+    bool skips_container(bool is_object)
+    {
+        if (builder) {
+            return false;
+        }
+        if (!selected()) {
+            return true;
+        }
+        if (path.size() == steps.size()) {
+            begin_match();
+            return false;
+        }
+        // enter the container only if the next step can select some of its children
+        const query::step& next = steps[path.size()];
+        return is_object ? !(next.by_name || next.all_members) : next.last <= next.first;
+    }
+
+    bool start_container(bool is_array)
+    {
+        if (builder) {
+            ++match_depth;
+            return is_array ? builder->start_array() : builder->start_object();
+        }
+        path.push_back({ is_array, 0 });
+        return true;
+    }
+
+    bool end_container(bool is_array)
+    {
+        if (builder) {
+            if (!(is_array ? builder->end_array() : builder->end_object())) {
+                return false;
+            }
+            return --match_depth > 0 || end_match();
+        }
+        path.pop_back();
+        return true;
+    }
+
+    bool null_value()
+    {
+        return scalar([](dom_builder& b) { return b.null_value(); });
+    }
+    bool bool_value(bool value)
+    {
+        return scalar([value](dom_builder& b) { return b.bool_value(value); });
+    }
+    bool int64_value(int64_t value)
+    {
+        return scalar([value](dom_builder& b) { return b.int64_value(value); });
+    }
+    bool uint64_value(uint64_t value)
+    {
+        return scalar([value](dom_builder& b) { return b.uint64_value(value); });
+    }
+    bool double_value(double value)
+    {
+        return scalar([value](dom_builder& b) { return b.double_value(value); });
+    }
+    bool string_value(const char* raw, size_t len, bool has_escapes)
+    {
+        return scalar([=](dom_builder& b) { return b.string_value(raw, len, has_escapes); });
+    }
+    bool key(const char* raw, size_t len, bool has_escapes)
+    {
+        if (builder) {
+            return builder->key(raw, len, has_escapes);
+        }
+        const query::step& s = steps[path.size() - 1];
+        if (s.all_members) {
+            member_selected = true;
+        } else if (!s.by_name || (!has_escapes && len != s.name.length())) {
+            member_selected = false;
+        } else if (!has_escapes) {
+            member_selected = memcmp(raw, s.name.data(), len) == 0;
+        } else {
+            scratch.resize(len);
+            member_selected = std::string_view(scratch.data(), unescape_string(raw, len, scratch.data())) == s.name;
+        }
+        return true;
+    }
+    bool start_object() { return start_container(false); }
+    bool end_object() { return end_container(false); }
+    bool start_array() { return start_container(true); }
+    bool end_array() { return end_container(true); }
+};
+} // namespace
+
+parse_result query::select(std::string_view content, const query_callback& callback) const
+{
+    if (!m_valid) {
+        return { parse_error::INVALID_QUERY };
+    }
+    parse_context ctx;
+    ctx.begin = content.data();
+    ctx.end = content.data() + content.length();
+    ctx.view = true;
+    // no structural index: most of the input is only skipped over
+    query_matcher matcher(ctx, *this, callback);
+    parse_result result = read(ctx, matcher);
+    // a single match query stops the parse itself once it found its match
+    return matcher.done ? parse_result{} : result;
+}
+
+document::document(size_t initial_size)
+    : m_arena(initial_size)
+    , m_root(&m_arena)
+{
+}
+
+void document::reset()
+{
+    // destroy the tree before rewinding the arena it lives in
+    m_root.~element();
+    m_arena.release();
+    new (&m_root) element(&m_arena);
+    m_batch_arenas.clear();
+    m_file.close();
+}
+
+parse_result document::parse(std::string_view content)
+{
+    reset();
+    return element::parse(content, &m_root);
+}
+
+namespace
+{
+/// inputs smaller than this are not worth parsing in parallel
+constexpr size_t PARALLEL_PARSE_MIN_SIZE = 1024 * 1024;
+
+/// find the elements of the top-level array from the structural index of `data`: element `i` starts with the
+/// index entry `starts[i]` and is followed by the `,` or `]` at entry `separators[i]`.
+/// Return false if `data` is not an array or if its brackets are unbalanced
+bool split_top_level_array(const char* data, const std::vector<uint32_t>& index, std::vector<size_t>* starts,
+                           std::vector<size_t>* separators)
+{
+    // the last entry is the terminator
+    size_t count = index.size() - 1;
+    if (count == 0 || data[index[0]] != '[') {
+        return false;
+    }
+
+    int depth = 1;
+    bool expect_element = true;
+    for (size_t j = 1; j < count; ++j) {
+        char c = data[index[j]];
+        if (depth == 1 && expect_element) {
+            if (c == ']' && starts->empty()) {
+                return true; // empty array
+            }
+            starts->push_back(j);
+            expect_element = false;
+        }
+
+        switch (c) {
+        case '"':
+            // skip the closing quote
+            ++j;
+            break;
+        case '[':
+        case '{':
+            ++depth;
+            break;
+        case ']':
+        case '}':
+            if (--depth == 0) {
+                separators->push_back(j);
+                return true;
+            }
+            break;
+        case ',':
+            if (depth == 1) {
+                separators->push_back(j);
+                expect_element = true;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return false;
+}
+} // namespace
+
+parse_result document::parse_parallel(std::string_view content, size_t threads)
+{
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const char* data = content.data();
+    const char* first = skip(data, data + content.length());
+    if (threads == 1 || content.length() < PARALLEL_PARSE_MIN_SIZE || first == data + content.length() ||
+        *first != '[') {
+        return parse(content);
+    }
+    // the elements are one level deep. An input that is not valid UTF-8 is left to the regular parser, which
+    // rejects or repairs it
+    parse_limits limits = get_parse_limits();
+    if (content.length() > limits.max_document_size || limits.max_depth == 0 ||
+        (get_utf8_mode() != utf8_mode::UNCHECKED && !is_valid_utf8(data, content.length()))) {
+        return parse(content);
+    }
+
+    // the index is built on this thread, the elements are then parsed with it
+    std::vector<uint32_t> index;
+    std::vector<size_t> starts;
+    std::vector<size_t> separators;
+    if (!build_structural_index(data, content.length(), &index) ||
+        !split_top_level_array(data, index, &starts, &separators) || starts.empty() ||
+        skip(data + index[separators.back()] + 1, data + content.length()) != data + content.length()) {
+        // let the regular parser handle empty arrays and fail the rest (e.g. content after the root array)
+        return parse(content);
+    }
+
+    if (starts.size() >= limits.max_elements) {
+        // the root and its elements are already too many values, do not allocate them
+        return parse(content);
+    }
+
+    TINYJSON_STAT(auto parse_start = std::chrono::steady_clock::now());
+    reset();
+    m_root.m_kind = element_kind::T_ARRAY;
+
+    // batches of about the same size, a few per thread for balance. Each batch has its own arena, so the
+    // workers never share an allocator
+    size_t batches_count = std::min(starts.size(), threads * 4);
+    size_t batch_size = content.length() / std::max<size_t>(batches_count, 1) + 1;
+    std::vector<size_t> batch_first;
+    for (size_t i = 0; i < starts.size(); ++i) {
+        if (batch_first.empty() || index[starts[i]] - index[starts[batch_first.back()]] >= batch_size) {
+            batch_first.push_back(i);
+        }
+    }
+    batch_first.push_back(starts.size());
+
+    m_root.m_children.reserve(starts.size());
+    TINYJSON_STAT(count_allocation(starts.size() * sizeof(element)));
+    for (size_t b = 0; b + 1 < batch_first.size(); ++b) {
+        m_batch_arenas.emplace_back(new std::pmr::monotonic_buffer_resource());
+        for (size_t i = batch_first[b]; i < batch_first[b + 1]; ++i) {
+            m_root.m_children.emplace_back(m_batch_arenas.back().get());
+        }
+    }
+
+    std::atomic<size_t> next_batch{ 0 };
+    std::atomic<bool> failed{ false };
+    // the values parsed by all the workers, the root array included. Only counted when `max_elements` is set,
+    // so the default unlimited parse does not contend on it
+    bool count_elements = limits.max_elements != std::numeric_limits<size_t>::max();
+    std::atomic<size_t> elements{ 1 };
+    // the statistics of every worker, the calling thread's own are set aside while it works
+    TINYJSON_STAT(std::vector<parse_stats> worker_stats(threads));
+    auto worker = [&]([[maybe_unused]] size_t worker_index) {
+        TINYJSON_STAT(parse_stats own_stats = current_stats; current_stats = parse_stats());
+        parse_context ctx;
+        ctx.begin = data;
+        ctx.end = data + content.length();
+        ctx.limits = limits;
+        --ctx.limits.max_depth;
+        dom_builder builder(ctx, nullptr);
+        reader<dom_builder> r{ ctx, builder };
+        for (size_t b = next_batch.fetch_add(1); b + 1 < batch_first.size() && !failed;
+             b = next_batch.fetch_add(1)) {
+            for (size_t i = batch_first[b]; i < batch_first[b + 1]; ++i) {
+                ctx.index = index.data() + starts[i];
+                builder.root = &m_root.m_children[i];
+                builder.parent = nullptr;
+                builder.member = nullptr;
+                builder.stack.clear();
+                // the element must end right before its separator
+                const char* value_end = ctx.skip(r.parse_value(data + index[starts[i]]));
+                if (value_end != data + index[separators[i]]) {
+                    failed = true;
+                    break;
+                }
+                // stop all the workers as soon as the total goes over the limit, not after parsing everything
+                if (count_elements) {
+                    if (elements.fetch_add(ctx.elements) + ctx.elements > limits.max_elements) {
+                        failed = true;
+                    }
+                    ctx.elements = 0;
+                }
+                if (failed) {
+                    break;
+                }
+            }
+        }
+        TINYJSON_STAT(worker_stats[worker_index] = current_stats; current_stats = own_stats);
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; ++t) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    if (failed) {
+        // the regular parser tells why the input failed (and counts its own statistics)
+        return parse(content);
+    }
+
+    // the root array, and the values of the workers which are one level below it
+    TINYJSON_STAT({
+        ++current_stats.nodes[static_cast<size_t>(element_kind::T_ARRAY)];
+        current_stats.bytes_parsed += content.length();
+        for (parse_stats& stats : worker_stats) {
+            stats.max_depth += 1;
+            merge_parse_stats(current_stats, stats);
+        }
+        current_stats.max_depth = std::max(current_stats.max_depth, 1u);
+        current_stats.parse_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                      std::chrono::steady_clock::now() - parse_start)
+                                      .count();
+    });
+    return parse_result{};
+}
+
+parse_result document::parse_insitu(char* buffer, size_t length)
+{
+    reset();
+    return element::parse_insitu(buffer, length, &m_root);
+}
+
+parse_result document::parse_view(std::string_view content)
+{
+    reset();
+    return element::parse_view(content, &m_root);
+}
+
+parse_result document::parse_lazy(std::string_view content)
+{
+    reset();
+    return element::parse_lazy(content, &m_root);
+}
+
+parse_result document::parse_file(const std::string& path)
+{
+    reset();
+    return element::parse_file(path, &m_root);
+}
+
+parse_result document::parse_file_view(const std::string& path)
+{
+    reset();
+    if (!m_file.open(path)) {
+        return { parse_error::FILE_ERROR };
+    }
+    return element::parse_view(m_file.view(), &m_root);
+}
+
+const element& element::operator[](std::string_view index) const
+{
+    size_t position = find_child(index);
+    if (position >= m_children.size()) {
+        return null_element;
+    }
+    return m_children[position];
+}
+
+element& element::operator[](std::string_view index)
+{
+    size_t position = find_child(index);
+    if (position >= m_children.size()) {
+        return null_element;
+    }
+    return m_children[position];
+}
+
+const element& element::operator[](const property_key& index) const
+{
+    size_t position = find_child(index);
+    if (position >= m_children.size()) {
+        return null_element;
+    }
+    return m_children[position];
+}
+
+element& element::operator[](const property_key& index)
+{
+    size_t position = find_child(index);
+    if (position >= m_children.size()) {
+        return null_element;
+    }
+    return m_children[position];
+}
+
+const element& element::operator[](size_t index) const
+{
+    if (index >= size()) {
+        return null_element;
+    }
+    return m_children[index];
+}
+
+element& element::operator[](size_t index)
+{
+    if (index >= size()) {
+        return null_element;
+    }
+    return m_children[index];
+}
+
+element& element::add_property_internal(const std::string& name)
+{
+    expand_if_lazy();
+    auto& elem = append_new();
+    elem.set_property_name(name.c_str(), name.length());
+
+    // add new indexed entry
+    index_child(m_children.size() - 1);
+    return elem;
+}
+
+element& element::add_element(element&& elem)
+{
+    expand_if_lazy();
+    m_children.emplace_back(std::move(elem));
+    index_child(m_children.size() - 1);
+    return m_children.back();
+}
+
+element& element::add_array(const std::string& name)
+{
+    element arr(resource());
+    create_array(&arr);
+    arr.set_property_name(name.c_str(), name.length());
+    return add_element(std::move(arr));
+}
+
+element& element::add_object(const std::string& name)
+{
+    element obj(resource());
+    create_object(&obj);
+    obj.set_property_name(name.c_str(), name.length());
+    return add_element(std::move(obj));
+}
+
+element& element::add_property(const std::string& name, int value)
+{
+    return add_property(name, static_cast<long>(value));
+}
+
+element& element::add_property(const std::string& name, long value)
+{
+    auto& elem = add_property_internal(name);
+    elem.set_int_value(value);
+    return *this;
+}
+
+element& element::add_property(const std::string& name, size_t value)
+{
+    auto& elem = add_property_internal(name);
+    elem.set_uint_value(value);
+    return *this;
+}
+
+element& element::add_property(const std::string& name, double value)
+{
+    auto& elem = add_property_internal(name);
+    elem.m_value.number = value;
+    elem.m_kind = element_kind::T_NUMBER;
+    return *this;
+}
+
+element& element::add_property(const std::string& name, const std::string& value)
+{
+    auto& elem = add_property_internal(name);
+    elem.set_str_value(value.c_str(), value.length());
+    return *this;
+}
+
+element& element::add_property(const std::string& name, const char* value)
+{
+    auto& elem = add_property_internal(name);
+    elem.set_str_value(value, strlen(value));
+    return *this;
+}
+
+element& element::add_property(const std::string& name, bool b)
+{
+    auto& elem = add_property_internal(name);
+    elem.m_value.boolean = b;
+    elem.m_kind = b ? element_kind::T_TRUE : element_kind::T_FALSE;
+    return *this;
+}
+
+element& element::add_property_null(const std::string& name)
+{
+    auto& elem = add_property_internal(name);
+    elem.m_kind = element_kind::T_NULL;
+    return *this;
+}
+
+element& element::add_array_item(const std::string& value)
+{
+    auto& elem = add_property_internal("");
+    elem.set_str_value(value.c_str(), value.length());
+    return *this;
+}
+
+element& element::add_array_item(const char* value)
+{
+    auto& elem = add_property_internal("");
+    elem.set_str_value(value, strlen(value));
+    return *this;
+}
+
+element& element::add_array_item(double value)
+{
+    auto& elem = add_property_internal("");
+    elem.m_kind = element_kind::T_NUMBER;
+    elem.m_value.number = value;
+    return *this;
+}
+
+element& element::add_array_item(int value) { return add_array_item(static_cast<long>(value)); }
+
+element& element::add_array_item(long value)
+{
+    auto& elem = add_property_internal("");
+    elem.set_int_value(value);
+    return *this;
+}
+
+element& element::add_array_item(size_t value)
+{
+    auto& elem = add_property_internal("");
+    elem.set_uint_value(value);
+    return *this;
+}
+
+element& element::add_array_item(bool value)
+{
+    auto& elem = add_property_internal("");
+    elem.m_kind = value ? element_kind::T_TRUE : element_kind::T_FALSE;
+    elem.m_value.boolean = value;
+    return *this;
+}
+
+element& element::add_array_item(element elem) { return add_element(std::move(elem)); }
+
+element& element::add_array_object()
+{
+    expand_if_lazy();
+    auto& elem = append_new();
+    elem.m_kind = element_kind::T_OBJECT;
+    return elem;
+}
+
+} // namespace tinyjson
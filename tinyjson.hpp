@@ -1,365 +1,1629 @@
-#ifndef JSON_LITE_HPP
-#define JSON_LITE_HPP
-
-#include <cstring>
-#include <memory>
-#include <sstream>
-#include <string>
-#include <unordered_map>
-#include <variant>
-#include <vector>
-
-namespace tinyjson
-{
-#define FLATTEN_INLINE inline __attribute__((flatten))
-
-enum class element_kind { T_INVALID, T_TRUE, T_FALSE, T_STRING, T_NUMBER, T_OBJECT, T_ARRAY, T_NULL };
-
-std::string& escape_string(const std::string_view& str, std::string* escaped);
-
-union element_value {
-    char* str;
-    double number;
-    bool boolean;
-};
-
-struct element {
-private:
-    /// the element's kind
-    element_kind m_kind = element_kind::T_INVALID;
-    /// if the Element has a name -> its here
-    std::string m_property_name;
-    /// the element's value
-    element_value m_value;
-    /// list of all children
-    std::vector<element> m_children;
-    /// provide `O(1)` access for elements by name
-    std::unordered_map<std::string, element*> m_elements_map;
-
-private:
-    static const char* parse_string(tinyjson::element* item, const char* str);
-    static const char* parse_number(tinyjson::element* item, const char* num);
-    static const char* parse_array(tinyjson::element* item, const char* value);
-    static const char* parse_object(tinyjson::element* item, const char* value);
-    static const char* parse_value(tinyjson::element* item, const char* value);
-
-    void index_elements();
-
-private:
-    /// append new item to the end of the children list and return a reference to it
-    FLATTEN_INLINE element& append_new()
-    {
-        element new_elem;
-        m_children.push_back(std::move(new_elem));
-        return m_children.back();
-    }
-
-    FLATTEN_INLINE const char* suffix(bool is_last, bool pretty) const
-    {
-        if (is_last) {
-            return pretty ? "\n" : "";
-        } else {
-            return pretty ? ",\n" : ",";
-        }
-    }
-
-    /// new property element with a given name
-    /// and return it. This method does not set the value
-    /// but it does add the newly added item to the index
-    /// table
-    element& add_property_internal(const std::string& name);
-
-public:
-    /// construct json from string
-    static bool parse(const std::string& content, element* root);
-
-    /// construct json from file
-    static bool parse_file(const std::string& path, element* root);
-
-    static bool create_array(element* arr);
-    static bool create_object(element* obj);
-
-    element();
-
-    // no copy constructor is allowed, only `move`
-    element(element& other) = delete;
-
-    element(element&& other);
-    ~element();
-
-    // Check functions
-    FLATTEN_INLINE bool is_array() const { return m_kind == element_kind::T_ARRAY; }
-    FLATTEN_INLINE bool is_object() const { return m_kind == element_kind::T_OBJECT; }
-    FLATTEN_INLINE bool is_string() const { return m_kind == element_kind::T_STRING; }
-    FLATTEN_INLINE bool is_number() const { return m_kind == element_kind::T_NUMBER; }
-    FLATTEN_INLINE bool is_true() const { return m_kind == element_kind::T_TRUE; }
-    FLATTEN_INLINE bool is_false() const { return m_kind == element_kind::T_FALSE; }
-    FLATTEN_INLINE bool is_null() const { return m_kind == element_kind::T_NULL; }
-    FLATTEN_INLINE bool is_ok() const { return m_kind != element_kind::T_INVALID; }
-
-    // "as" methods
-    // element.as<std::string>
-
-    /// return the value as a string
-    /// @param val [output]
-    /// @param default_value default value to return in case of an error
-    template <typename T> FLATTEN_INLINE bool as_str(T* val, const char* default_value = "") const
-    {
-        if (!is_string()) {
-            *val = default_value;
-            return false;
-        }
-
-        *val = m_value.str;
-        return true;
-    }
-
-    /// return the value as a number. return the `default_value` on error
-    template <typename T> FLATTEN_INLINE T to_str(const char* default_value = "") const
-    {
-        T value;
-        as_str(&value, default_value);
-        return std::move(value);
-    }
-
-    /// return the value as a number. return false on error
-    /// @param val [output]
-    /// @param default_value default value to return in case of an error
-    template <typename T> FLATTEN_INLINE bool as_number(T* val, int default_value = -1) const
-    {
-        if (!is_number()) {
-            *val = static_cast<T>(default_value);
-            return false;
-        }
-
-        *val = static_cast<T>(m_value.number);
-        return true;
-    }
-
-    /// return the value as a number. return the `default_value` on error
-    template <typename T> FLATTEN_INLINE T to_number(int default_value = -1) const
-    {
-        T value;
-        as_number(&value, default_value);
-        return value;
-    }
-
-    /// return the value as a bool
-    /// @param val [output]
-    /// @param default_value default value to return in case of an error
-    FLATTEN_INLINE bool as_bool(bool* val, bool default_value = false) const
-    {
-        switch (m_kind) {
-        case element_kind::T_FALSE:
-            *val = false;
-            return true;
-        case element_kind::T_TRUE:
-            *val = true;
-            return true;
-        default:
-            return false;
-        }
-    }
-
-    /// return the value as a bool. return the `default_value` on error
-    FLATTEN_INLINE bool to_bool(bool default_value = false) const
-    {
-        bool v;
-        as_bool(&v, default_value);
-        return v;
-    }
-
-    /// access element by name
-    const element& operator[](const char* index) const;
-    element& operator[](const char* index);
-
-    FLATTEN_INLINE const element& operator[](const std::string& index) const { return operator[](index.c_str()); }
-    FLATTEN_INLINE element& operator[](const std::string& index) { return operator[](index.c_str()); }
-
-    /// access element by position
-    const element& operator[](size_t index) const;
-    element& operator[](size_t index);
-
-    FLATTEN_INLINE const element& operator[](int index) const { return operator[](static_cast<size_t>(index)); }
-    FLATTEN_INLINE element& operator[](int index) { return operator[](static_cast<size_t>(index)); }
-
-    /// STL like api, so we can have `for` loops
-    FLATTEN_INLINE std::vector<element>::const_iterator begin() const { return m_children.begin(); }
-    FLATTEN_INLINE std::vector<element>::iterator begin() { return m_children.begin(); }
-    FLATTEN_INLINE std::vector<element>::const_iterator end() const { return m_children.end(); }
-    FLATTEN_INLINE std::vector<element>::iterator end() { return m_children.end(); }
-
-    FLATTEN_INLINE std::vector<element>::size_type size() const { return m_children.size(); }
-    /// return true if this Element has no children
-    FLATTEN_INLINE bool empty() const { return m_children.empty(); }
-    /// delete all children
-    FLATTEN_INLINE void clear()
-    {
-        m_children.clear();
-        m_elements_map.clear();
-    }
-    /// return true if this Element contains a child with a given name
-    bool contains(const char* name) const;
-    /// return true if this Element contains a child with a given name
-    bool contains(const std::string& name) const;
-
-    // write API
-
-    /// add new property to the `this`. return ref to `this`
-    /// @return reference to `this`
-    element& add_property(const std::string& name, double value);
-
-    /// add new property to the `this`. return ref to `this`
-    /// @return reference to `this`
-    element& add_property(const std::string& name, int value);
-
-    /// add new property to the `this`. return ref to `this`
-    /// @return reference to `this`
-    element& add_property(const std::string& name, long value);
-
-    /// add new property to the `this`. return ref to `this`
-    /// @return reference to `this`
-    element& add_property(const std::string& name, size_t value);
-
-    /// add new property to the `this`. return ref to `this`
-    /// @return reference to `this`
-    element& add_property(const std::string& name, const std::string& value);
-
-    /// add new property to the `this`. return ref to `this`
-    /// @return reference to `this`
-    element& add_property(const std::string& name, const char* value);
-
-    /// add new property to the `this`. return ref to `this`
-    /// @return reference to `this`
-    element& add_property(const std::string& name, bool b);
-
-    /// add new property to the `this`. return ref to `this`
-    /// @return reference to `this`
-    element& add_element(element&& elem);
-
-    /// add new property to the `this`. return ref to `this`
-    /// @return reference to `this`
-    element& add_property_null(const std::string& name);
-
-    /// add new array with a given name. return the newly added Element
-    /// @return the newly added object
-    element& add_array(const std::string& name);
-
-    /// add new object with a given name. return the newly added Element
-    /// @return the newly added object
-    element& add_object(const std::string& name);
-
-    /// add an Element of type string to the array, return the array
-    /// @return reference to `this`
-    element& add_array_item(const std::string& value);
-
-    /// add an Element of type string to the array, return the array
-    /// @return reference to `this`
-    element& add_array_item(const char* value);
-
-    /// add an Element of type double to the array, return the array
-    /// @return reference to `this`
-    element& add_array_item(double value);
-
-    /// add an Element of type bool to the array, return the array
-    /// @return reference to `this`
-    element& add_array_item(bool b);
-
-    /// add an Element of type string to the array, return the array
-    /// @return reference to `this`
-    element& add_array_item(element elem);
-
-    /// create new empty Element of type object and append it to the end of the array
-    /// @return the newly added object
-    element& add_array_object();
-
-    FLATTEN_INLINE const char* property_name() const
-    {
-        if (m_property_name.empty()) {
-            return nullptr;
-        }
-        return m_property_name.c_str();
-    }
-
-    FLATTEN_INLINE void to_string(std::ostream& ss, int depth, bool last_child, bool pretty) const
-    {
-        std::string indent(depth, ' ');
-        if (!pretty) {
-            indent.clear();
-        }
-
-        const std::string NEW_LINE = pretty ? "\n" : "";
-        ss << indent;
-        if (property_name()) {
-            ss << "\"" << property_name() << "\":" << (pretty ? " " : "");
-        }
-
-        switch (m_kind) {
-        case element_kind::T_STRING: {
-            std::string_view sv;
-            as_str(&sv);
-            if (sv.empty()) {
-                ss << R"("")" << suffix(last_child, pretty);
-            } else {
-                std::string escaped_str;
-                ss << escape_string(sv, &escaped_str) << suffix(last_child, pretty);
-            }
-        } break;
-        case element_kind::T_NUMBER: {
-            double d;
-            as_number(&d);
-            ss << d << suffix(last_child, pretty);
-        } break;
-        case element_kind::T_TRUE: {
-            ss << "true" << suffix(last_child, pretty);
-        } break;
-        case element_kind::T_FALSE: {
-            ss << "false" << suffix(last_child, pretty);
-        } break;
-        case element_kind::T_NULL: {
-            ss << "null" << suffix(last_child, pretty);
-        } break;
-        case element_kind::T_OBJECT: {
-            if (m_children.empty()) {
-                ss << "{}" << suffix(last_child, pretty);
-            } else {
-                ss << "{" << NEW_LINE;
-                for (size_t i = 0; i < m_children.size(); ++i) {
-                    bool is_last = i == m_children.size() - 1;
-                    m_children[i].to_string(ss, depth + 1, is_last, pretty);
-                }
-                ss << indent << "}" << suffix(last_child, pretty);
-            }
-        } break;
-        case element_kind::T_ARRAY: {
-            if (m_children.empty()) {
-                ss << "[]" << suffix(last_child, pretty);
-            } else {
-                ss << "[" << NEW_LINE;
-                for (size_t i = 0; i < m_children.size(); ++i) {
-                    bool is_last = i == m_children.size() - 1;
-                    m_children[i].to_string(ss, depth + 1, is_last, pretty);
-                }
-                ss << indent << "]" << suffix(last_child, pretty);
-            }
-        } break;
-        case element_kind::T_INVALID:
-            break;
-        }
-    }
-};
-
-FLATTEN_INLINE void to_string(const element& root, std::ostream& ss, bool pretty = true)
-{
-    root.to_string(ss, 0, true, pretty);
-}
-
-/// For convenience. Same as calling `tinyjson::element::parse`
-FLATTEN_INLINE bool parse(const std::string& content, element* root) { return element::parse(content, root); }
-
-/// For convenience. Same as calling `tinyjson::element::parse_file`
-FLATTEN_INLINE bool parse_file(const std::string& content, element* root) { return element::parse_file(content, root); }
-
-} // namespace tinyjson
-
-#endif // JSON_LITE_HPP
+#ifndef JSON_LITE_HPP
+#define JSON_LITE_HPP
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TINYJSON_X86 1
+#else
+#define TINYJSON_X86 0
+#endif
+
+namespace tinyjson
+{
+#define FLATTEN_INLINE inline __attribute__((flatten))
+
+/// `T_NUMBER` holds a double, `T_INT64` and `T_UINT64` hold integers (number literals without a fraction or an
+/// exponent). `T_UINT64` is only used for values above `INT64_MAX`
+enum class element_kind {
+    T_INVALID,
+    T_TRUE,
+    T_FALSE,
+    T_STRING,
+    T_NUMBER,
+    T_OBJECT,
+    T_ARRAY,
+    T_NULL,
+    T_INT64,
+    T_UINT64
+};
+
+std::string& escape_string(const std::string_view& str, std::string* escaped);
+
+/// the instruction sets used by the vectorized parts of the parser
+enum class simd_level { SCALAR, SSE42, AVX2 };
+
+/// return the best instruction set supported by this CPU
+simd_level detect_simd_level();
+
+/// return the instruction set used by the parser. Defaults to `detect_simd_level()`
+simd_level get_simd_level();
+
+/// override the instruction set used by the parser (e.g. for benchmarks). A level not supported by
+/// this CPU is lowered to the best one that is. With `SCALAR`, the parser does not build a structural index
+void set_simd_level(simd_level level);
+
+/// build the structural index of `data`: the offsets (in order) of all the tokens outside of strings, i.e.
+/// the structural characters, the opening and closing quotes of strings and the first character of numbers
+/// and literals. The index is terminated with `len`. Return false if `data` ends inside a string or if it
+/// is too large to be indexed (4GB)
+bool build_structural_index(const char* data, size_t len, std::vector<uint32_t>* index);
+
+/// build the library with `TINYJSON_STATS=1` (the CMake option of the same name) to collect `parse_stats`.
+/// Otherwise the counters are compiled out and the statistics stay zero
+#ifndef TINYJSON_STATS
+#define TINYJSON_STATS 0
+#endif
+
+/// Statistics of the trees built by the parser (`element::parse` and its variants, `document::parse`) and of the
+/// serializer (`to_string`), accumulated per thread until `reset_parse_stats()`. Only collected when the library
+/// is built with `TINYJSON_STATS`
+struct parse_stats {
+    /// input bytes parsed
+    uint64_t bytes_parsed = 0;
+    /// output bytes written by `to_string`
+    uint64_t bytes_serialized = 0;
+    /// values parsed, by `element_kind`
+    uint64_t nodes[static_cast<size_t>(element_kind::T_UINT64) + 1] = {};
+    /// deepest nesting of arrays and objects seen, e.g. 2 for `[[1]]`
+    uint32_t max_depth = 0;
+    /// raw bytes of the strings and names that contained escape sequences and were decoded
+    uint64_t unescaped_bytes = 0;
+    /// allocations made for the trees (strings, names and children lists) from their memory resource, and their size
+    uint64_t allocations = 0;
+    uint64_t allocated_bytes = 0;
+    /// time spent building the structural index, parsing (including the index) and serializing, in nanoseconds
+    uint64_t index_ns = 0;
+    uint64_t parse_ns = 0;
+    uint64_t serialize_ns = 0;
+
+    FLATTEN_INLINE uint64_t node_count(element_kind kind) const { return nodes[static_cast<size_t>(kind)]; }
+};
+
+/// the statistics of the calling thread
+const parse_stats& get_parse_stats();
+
+/// zero the statistics of the calling thread
+void reset_parse_stats();
+
+/// Limits on the input accepted by the parsers, so a hostile input can not exhaust the memory or the time of a
+/// service. A parse fails as soon as a limit is exceeded, see `parse_error`
+struct parse_limits {
+    /// the deepest nesting of arrays and objects, e.g. 2 for `[[1]]`. The parser itself does not recurse, the
+    /// default keeps the recursive parts of the library (e.g. destroying or writing a tree) within small stacks
+    size_t max_depth = 1024;
+    /// the size of the input in bytes
+    size_t max_document_size = std::numeric_limits<size_t>::max();
+    /// the length of a string or a property name in bytes, as written in the input (before decoding)
+    size_t max_string_length = std::numeric_limits<size_t>::max();
+    /// the number of values in the input, arrays and objects included
+    size_t max_elements = std::numeric_limits<size_t>::max();
+};
+
+/// return the limits used by the parsers
+parse_limits get_parse_limits();
+
+/// set the limits used by all the parsers, on all threads, starting with the next parse
+void set_parse_limits(const parse_limits& limits);
+
+/// How the parsers treat text that is not valid UTF-8: byte sequences that are not UTF-8 (overlong forms, encoded
+/// surrogates, code points above U+10FFFF, truncated sequences) and `\u` escapes of unpaired UTF-16 surrogates
+enum class utf8_mode {
+    /// fail the parse (`parse_error::INVALID_UTF8`, or `parse_error::BAD_ESCAPE` for an unpaired surrogate)
+    STRICT,
+    /// replace every invalid sequence inside the strings with U+FFFD, the replacement character. Invalid bytes
+    /// outside of the strings are still unexpected characters
+    REPLACE,
+    /// pass the bytes through unchecked. An unpaired surrogate is still decoded as U+FFFD
+    UNCHECKED,
+};
+
+/// return the mode used by the parsers, `utf8_mode::STRICT` by default
+utf8_mode get_utf8_mode();
+
+/// set the mode used by all the parsers, on all threads, starting with the next parse
+void set_utf8_mode(utf8_mode mode);
+
+/// return true if `data` is valid UTF-8. The check uses the active `simd_level`
+bool is_valid_utf8(const char* data, size_t len);
+
+/// why a parse failed
+enum class parse_error {
+    NONE,
+    /// a byte that can not start or continue a value here, e.g. `[1 2]` or `tru`
+    UNEXPECTED_CHARACTER,
+    /// the input ends inside a value, e.g. `[1,`
+    UNEXPECTED_END,
+    /// a string without its closing quote, the offset is the opening quote
+    UNTERMINATED_STRING,
+    /// an unknown escape sequence, a `\u` not followed by 4 hexadecimal digits or (with `utf8_mode::STRICT`) an
+    /// unpaired surrogate
+    BAD_ESCAPE,
+    /// the input is not valid UTF-8, see `utf8_mode`
+    INVALID_UTF8,
+    /// something else than whitespace follows the value
+    TRAILING_CONTENT,
+    /// a handler callback returned false (e.g. `from_json` met a value of the wrong type)
+    STOPPED,
+    /// the file could not be opened or mapped (`parse_file`)
+    FILE_ERROR,
+    /// a limit was exceeded, see `parse_limits`
+    DOCUMENT_TOO_LARGE,
+    TOO_DEEP,
+    STRING_TOO_LONG,
+    TOO_MANY_ELEMENTS,
+    /// `query::select` was given a query that failed to compile
+    INVALID_QUERY,
+};
+
+/// the name of `error`, e.g. "unexpected character"
+const char* to_string(parse_error error);
+
+/// The outcome of a parse. It converts explicitly to `bool` (true on success), so `if (parse(...))` still works.
+/// On failure it tells why and where: `offset` is the byte of the input where the parse stopped. The line and the
+/// column are only computed when asked for, by scanning the input up to `offset`, so the input must still be valid
+/// then. The parsers that do not keep their input (`parse_file` and `push_parser`) compute them before returning a
+/// failure. After `parse_insitu`, the lines are counted in the buffer as modified by the parse
+class parse_result
+{
+public:
+    parse_result() = default;
+    parse_result(parse_error reason, size_t at = 0, const char* input = nullptr)
+        : error(reason)
+        , offset(at)
+        , m_input(input)
+    {
+    }
+
+    parse_error error = parse_error::NONE;
+    /// the offset of the failure in the input, in bytes
+    size_t offset = 0;
+
+    FLATTEN_INLINE bool ok() const { return error == parse_error::NONE; }
+    FLATTEN_INLINE explicit operator bool() const { return ok(); }
+
+    /// the line of the failure, starting at 1
+    size_t line() const;
+    /// the column of the failure in bytes, starting at 1
+    size_t column() const;
+
+private:
+    friend struct push_state;
+
+    /// count the lines and columns up to `offset`, once
+    void locate() const;
+
+    /// the first byte of the input, until the position is located
+    mutable const char* m_input = nullptr;
+    mutable size_t m_line = 0;
+    mutable size_t m_column = 0;
+};
+
+union element_value {
+    char* str;
+    double number;
+    int64_t int64;
+    uint64_t uint64;
+    bool boolean;
+};
+
+/// 32 bit FNV-1a hash of a property name, as used by the name index of objects
+constexpr uint32_t hash_property_name(std::string_view name)
+{
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+/// A property name with its hash computed once, for names that are looked up in many objects. Declare it once,
+/// e.g. `static constexpr tinyjson::property_key NAME("name");` (the hash is then computed at compile time), and
+/// pass it to `element::operator[]` or `element::contains`. It does not copy the name, which must outlive it
+class property_key
+{
+public:
+    constexpr explicit property_key(std::string_view name)
+        : m_name(name)
+        , m_hash(hash_property_name(name))
+    {
+    }
+
+    constexpr std::string_view name() const { return m_name; }
+    constexpr uint32_t hash() const { return m_hash; }
+
+private:
+    friend class query;
+
+    /// `hash` must be `hash_property_name(name)`
+    constexpr property_key(std::string_view name, uint32_t hash)
+        : m_name(name)
+        , m_hash(hash)
+    {
+    }
+
+    std::string_view m_name;
+    uint32_t m_hash = 0;
+};
+
+/// SAX style callbacks, invoked by `tinyjson::parse(content, handler*)` while it walks the input. No tree is
+/// built, so memory use does not depend on the input size. Every callback returns `true` to continue or `false`
+/// to stop the parse (which then fails). The default implementations accept and ignore the event
+///
+/// Strings and keys are passed decoded. Their views are only valid during the callback, copy them if needed.
+/// Integers are passed to `int64_value`, unless they are above `INT64_MAX` (`uint64_value`), everything else
+/// (fraction, exponent, out of the 64 bit range or `-0`) to `double_value`
+class handler
+{
+public:
+    virtual ~handler() = default;
+
+    virtual bool null_value() { return true; }
+    virtual bool bool_value(bool /*value*/) { return true; }
+    virtual bool int64_value(int64_t /*value*/) { return true; }
+    virtual bool uint64_value(uint64_t /*value*/) { return true; }
+    virtual bool double_value(double /*value*/) { return true; }
+    virtual bool string_value(std::string_view /*value*/) { return true; }
+    /// an object member's name. It is followed by the member's value
+    virtual bool key(std::string_view /*name*/) { return true; }
+    virtual bool start_object() { return true; }
+    virtual bool end_object() { return true; }
+    virtual bool start_array() { return true; }
+    virtual bool end_array() { return true; }
+};
+
+/// The read accessors shared by `element` and `tape_element`. `Derived` provides `kind()`, `value()` (the value of
+/// numbers and booleans) and `str_view()` (the value of strings)
+template <typename Derived> struct value_reader {
+    // Check functions
+    FLATTEN_INLINE bool is_array() const { return self().kind() == element_kind::T_ARRAY; }
+    FLATTEN_INLINE bool is_object() const { return self().kind() == element_kind::T_OBJECT; }
+    FLATTEN_INLINE bool is_string() const { return self().kind() == element_kind::T_STRING; }
+    /// true for all the number kinds: double and integers
+    FLATTEN_INLINE bool is_number() const
+    {
+        return self().kind() == element_kind::T_NUMBER || self().kind() == element_kind::T_INT64 ||
+               self().kind() == element_kind::T_UINT64;
+    }
+    /// true if the number is stored as an integer (`T_INT64` or `T_UINT64`)
+    FLATTEN_INLINE bool is_integer() const
+    {
+        return self().kind() == element_kind::T_INT64 || self().kind() == element_kind::T_UINT64;
+    }
+    FLATTEN_INLINE bool is_true() const { return self().kind() == element_kind::T_TRUE; }
+    FLATTEN_INLINE bool is_false() const { return self().kind() == element_kind::T_FALSE; }
+    FLATTEN_INLINE bool is_null() const { return self().kind() == element_kind::T_NULL; }
+    FLATTEN_INLINE bool is_ok() const { return self().kind() != element_kind::T_INVALID; }
+
+    // "as" methods
+    // element.as<std::string>
+
+    /// return the value as a string
+    /// @param val [output]
+    /// @param default_value default value to return in case of an error
+    /// `T` can be any type assignable from `std::string_view`, use `std::string_view` to avoid copying
+    template <typename T> FLATTEN_INLINE bool as_str(T* val, const char* default_value = "") const
+    {
+        if (!is_string()) {
+            *val = default_value;
+            return false;
+        }
+
+        *val = self().str_view();
+        return true;
+    }
+
+    /// return the value as a number. return the `default_value` on error
+    template <typename T> FLATTEN_INLINE T to_str(const char* default_value = "") const
+    {
+        T value;
+        as_str(&value, default_value);
+        return value;
+    }
+
+    /// return the value as a number. return false on error
+    /// @param val [output]
+    /// @param default_value default value to return in case of an error
+    template <typename T> FLATTEN_INLINE bool as_number(T* val, int default_value = -1) const
+    {
+        switch (self().kind()) {
+        case element_kind::T_NUMBER:
+            *val = static_cast<T>(self().value().number);
+            return true;
+        case element_kind::T_INT64:
+            *val = static_cast<T>(self().value().int64);
+            return true;
+        case element_kind::T_UINT64:
+            *val = static_cast<T>(self().value().uint64);
+            return true;
+        default:
+            *val = static_cast<T>(default_value);
+            return false;
+        }
+    }
+
+    /// return the value as a number. return the `default_value` on error
+    template <typename T> FLATTEN_INLINE T to_number(int default_value = -1) const
+    {
+        T value;
+        as_number(&value, default_value);
+        return value;
+    }
+
+    /// return the value as a signed 64 bit integer, without going through a double. Doubles are accepted only when
+    /// they hold an integral value in range. return false on error
+    /// @param val [output]
+    /// @param default_value default value to return in case of an error
+    FLATTEN_INLINE bool as_int64(int64_t* val, int64_t default_value = -1) const
+    {
+        switch (self().kind()) {
+        case element_kind::T_INT64:
+            *val = self().value().int64;
+            return true;
+        case element_kind::T_UINT64:
+            break;
+        case element_kind::T_NUMBER:
+            if (self().value().number >= -9223372036854775808.0 && self().value().number < 9223372036854775808.0 &&
+                static_cast<double>(static_cast<int64_t>(self().value().number)) == self().value().number) {
+                *val = static_cast<int64_t>(self().value().number);
+                return true;
+            }
+            break;
+        default:
+            break;
+        }
+        *val = default_value;
+        return false;
+    }
+
+    /// return the value as a signed 64 bit integer. return the `default_value` on error
+    FLATTEN_INLINE int64_t to_int64(int64_t default_value = -1) const
+    {
+        int64_t value;
+        as_int64(&value, default_value);
+        return value;
+    }
+
+    /// return the value as an unsigned 64 bit integer, without going through a double. Doubles are accepted only
+    /// when they hold an integral value in range. return false on error
+    /// @param val [output]
+    /// @param default_value default value to return in case of an error
+    FLATTEN_INLINE bool as_uint64(uint64_t* val, uint64_t default_value = 0) const
+    {
+        switch (self().kind()) {
+        case element_kind::T_INT64:
+            if (self().value().int64 >= 0) {
+                *val = static_cast<uint64_t>(self().value().int64);
+                return true;
+            }
+            break;
+        case element_kind::T_UINT64:
+            *val = self().value().uint64;
+            return true;
+        case element_kind::T_NUMBER:
+            if (self().value().number >= 0.0 && self().value().number < 18446744073709551616.0 &&
+                static_cast<double>(static_cast<uint64_t>(self().value().number)) == self().value().number) {
+                *val = static_cast<uint64_t>(self().value().number);
+                return true;
+            }
+            break;
+        default:
+            break;
+        }
+        *val = default_value;
+        return false;
+    }
+
+    /// return the value as an unsigned 64 bit integer. return the `default_value` on error
+    FLATTEN_INLINE uint64_t to_uint64(uint64_t default_value = 0) const
+    {
+        uint64_t value;
+        as_uint64(&value, default_value);
+        return value;
+    }
+
+    /// return the value as a bool
+    /// @param val [output]
+    /// @param default_value default value to return in case of an error
+    FLATTEN_INLINE bool as_bool(bool* val, bool default_value = false) const
+    {
+        switch (self().kind()) {
+        case element_kind::T_FALSE:
+            *val = false;
+            return true;
+        case element_kind::T_TRUE:
+            *val = true;
+            return true;
+        default:
+            *val = default_value;
+            return false;
+        }
+    }
+
+    /// return the value as a bool. return the `default_value` on error
+    FLATTEN_INLINE bool to_bool(bool default_value = false) const
+    {
+        bool v;
+        as_bool(&v, default_value);
+        return v;
+    }
+
+private:
+    FLATTEN_INLINE const Derived& self() const { return static_cast<const Derived&>(*this); }
+};
+
+struct document;
+struct parse_context;
+struct dom_builder;
+struct lazy_builder;
+
+struct element : public value_reader<element> {
+    friend struct document;
+    friend struct dom_builder;
+    friend struct lazy_builder;
+    friend struct value_reader<element>;
+
+private:
+    /// `m_flags` bits
+    enum {
+        /// `m_value.str` points into a buffer owned by the caller (in-situ parsing)
+        F_BORROWED_STR = (1 << 0),
+        /// `m_property_name` points into a buffer owned by the caller (in-situ parsing)
+        F_BORROWED_NAME = (1 << 1),
+        /// `m_value.str` is the raw (still escaped) string. It is decoded on first read (view parsing)
+        F_ESCAPED_STR = (1 << 2),
+        /// `m_property_name` is the raw (still escaped) name. It is decoded on first read (view parsing)
+        F_ESCAPED_NAME = (1 << 3),
+        /// `m_property_name` is not NULL terminated (view parsing)
+        F_UNTERMINATED_NAME = (1 << 4),
+        /// an array or an object whose children are not parsed yet, `m_value.str` and `m_str_len` hold its raw
+        /// text. They are parsed on first access (lazy parsing)
+        F_LAZY = (1 << 5),
+    };
+
+    /// the element's kind
+    element_kind m_kind = element_kind::T_INVALID;
+    /// see the `F_*` bits above
+    uint8_t m_flags = 0;
+    /// length of `m_value.str` (when the element is a string)
+    size_t m_str_len = 0;
+    /// length of `m_property_name`
+    size_t m_property_name_len = 0;
+    /// if the Element has a name -> its here
+    char* m_property_name = nullptr;
+    /// the element's value
+    element_value m_value;
+    /// list of all children. The vector's memory resource is also the resource from which
+    /// this element's strings (value and property name) are allocated
+    std::pmr::vector<element> m_children;
+
+    /// a slot of `m_key_index`
+    struct key_slot {
+        /// hash of the child's property name
+        uint32_t hash;
+        /// the child's position in `m_children` plus one, `0` marks a free slot
+        uint32_t position;
+    };
+
+    /// objects with fewer children are searched with a linear scan, which is cheaper than building an index
+    static constexpr size_t KEY_INDEX_MIN_SIZE = 8;
+
+    /// provide `O(1)` access for elements by name: an open addressing hash table of positions in `m_children`
+    /// (which, unlike pointers, stay valid when `m_children` grows). Built on the first lookup by name, and only
+    /// for objects with at least `KEY_INDEX_MIN_SIZE` children
+    std::pmr::vector<key_slot> m_key_index;
+
+private:
+    /// parse the whole input described by `ctx` into `root`
+    static parse_result parse_root(parse_context& ctx, element* root);
+
+    /// return the position of the first child named `name`, or `m_children.size()` if there is none
+    size_t find_child(std::string_view name) const;
+    size_t find_child(const property_key& key) const;
+
+    /// `find_child` for objects with less than `KEY_INDEX_MIN_SIZE` children
+    size_t scan_children(std::string_view name) const;
+
+    /// `find_child` for the larger objects, `hash` is the hash of `name`
+    size_t find_indexed_child(std::string_view name, uint32_t hash) const;
+
+    /// (re)build `m_key_index` from all the named children
+    void build_key_index();
+
+    /// add the child at `position` to `m_key_index`, if the index was built
+    void index_child(size_t position);
+
+    /// parse the children of a lazy array or object (see `F_LAZY`), keeping their own children lazy.
+    /// Kept out of line: the accessors calling `expand_if_lazy` are flattened, and would otherwise pull the
+    /// whole parser into every caller
+    __attribute__((noinline, cold)) void expand_lazy();
+
+    inline void expand_if_lazy() const
+    {
+        if (m_flags & F_LAZY) {
+            const_cast<element*>(this)->expand_lazy();
+        }
+    }
+
+    /// the memory resource used for this element's strings and children
+    FLATTEN_INLINE std::pmr::memory_resource* resource() const { return m_children.get_allocator().resource(); }
+
+    /// allocate a NULL terminated copy of `str` from this element's memory resource
+    char* new_string(const char* str, size_t len) const;
+
+    /// free the value string and the property name back to the memory resource
+    void release_strings();
+
+    void set_property_name(const char* name, size_t len);
+    void set_str_value(const char* str, size_t len);
+    void set_int_value(int64_t value);
+    void set_uint_value(uint64_t value);
+
+    /// replace the raw string value of a view-parsed element with its decoded version
+    void decode_str_value();
+    /// replace the raw property name of a view-parsed element with its decoded (and NULL terminated) version
+    void decode_property_name();
+
+    /// the value of numbers and booleans
+    FLATTEN_INLINE const element_value& value() const { return m_value; }
+
+    /// the string value, without copying it
+    FLATTEN_INLINE std::string_view str_view() const
+    {
+        if (m_flags & F_ESCAPED_STR) {
+            const_cast<element*>(this)->decode_str_value();
+        }
+        return { m_value.str, m_str_len };
+    }
+
+private:
+    /// append new item to the end of the children list and return a reference to it
+    FLATTEN_INLINE element& append_new()
+    {
+        m_children.emplace_back(resource());
+        return m_children.back();
+    }
+
+    /// new property element with a given name
+    /// and return it. This method does not set the value
+    /// but it does add the newly added item to the index
+    /// table
+    element& add_property_internal(const std::string& name);
+
+public:
+    /// construct json from string. The parser stays within `content.length()` bytes, so `content` does not need
+    /// to be NULL terminated (e.g. a slice of a larger buffer). Embedded NULs (raw or `\u0000`) are kept.
+    /// The parse fails if the input is malformed or exceeds the `parse_limits`, the result tells why
+    static parse_result parse(std::string_view content, element* root);
+
+    /// construct json from the `length` bytes at `data`, see `parse(std::string_view, element*)`
+    FLATTEN_INLINE static parse_result parse(const char* data, size_t length, element* root)
+    {
+        return parse(std::string_view(data, length), root);
+    }
+
+    /// construct json from a mutable buffer of `length` bytes. Strings are unescaped inside `buffer`
+    /// itself and the string values and property names of the tree point into it, so parsing does not
+    /// allocate or copy strings. `buffer` is modified and must outlive `root`
+    static parse_result parse_insitu(char* buffer, size_t length, element* root);
+
+    /// construct json from a read-only buffer without copying its strings. String values and property names
+    /// are views into `content`, strings containing escape sequences are only decoded when they are first read.
+    /// `content` must outlive `root`. Note that the lazy decoding makes the first read of such strings a write,
+    /// so concurrent readers should not share a view-parsed tree before reading it once
+    static parse_result parse_view(std::string_view content, element* root);
+
+    /// like `parse_view`, but arrays and objects are not parsed until they are first accessed (through
+    /// `operator[]`, `contains`, `size` or iteration), and then only one level deep. Until then they are only
+    /// skipped over by matching their brackets, so unread parts of the input cost little more than a scan.
+    /// As a consequence, errors inside an array or an object are only detected when it is accessed: it then
+    /// becomes invalid (`is_ok()` returns false) and empty. `content` must outlive `root`, and as with
+    /// `parse_view` the first access is a write, even through a `const` reference: a lazily parsed tree is not
+    /// safe for concurrent reads, threads sharing it must serialize their accesses
+    static parse_result parse_lazy(std::string_view content, element* root);
+
+    /// construct json from file. The file is memory mapped and parsed straight from the mapping
+    static parse_result parse_file(const std::string& path, element* root);
+
+    static bool create_array(element* arr);
+    static bool create_object(element* obj);
+
+    element();
+
+    /// construct an element that allocates its strings and children from `resource`
+    explicit element(std::pmr::memory_resource* resource);
+
+    // no copy constructor is allowed, only `move`
+    element(element& other) = delete;
+
+    element(element&& other);
+    /// out of line: the destructor recurses into the children, inlining it into the flattened parser code only
+    /// unrolls that recursion
+    __attribute__((noinline)) ~element();
+
+    FLATTEN_INLINE element_kind kind() const { return m_kind; }
+
+    /// access element by name
+    const element& operator[](std::string_view index) const;
+    element& operator[](std::string_view index);
+
+    FLATTEN_INLINE const element& operator[](const char* index) const { return operator[](std::string_view(index)); }
+    FLATTEN_INLINE element& operator[](const char* index) { return operator[](std::string_view(index)); }
+    FLATTEN_INLINE const element& operator[](const std::string& index) const
+    {
+        return operator[](std::string_view(index));
+    }
+    FLATTEN_INLINE element& operator[](const std::string& index) { return operator[](std::string_view(index)); }
+
+    /// access element by name, without hashing the name again
+    const element& operator[](const property_key& index) const;
+    element& operator[](const property_key& index);
+
+    /// access element by position
+    const element& operator[](size_t index) const;
+    element& operator[](size_t index);
+
+    FLATTEN_INLINE const element& operator[](int index) const { return operator[](static_cast<size_t>(index)); }
+    FLATTEN_INLINE element& operator[](int index) { return operator[](static_cast<size_t>(index)); }
+
+    /// STL like api, so we can have `for` loops
+    FLATTEN_INLINE std::pmr::vector<element>::const_iterator begin() const
+    {
+        expand_if_lazy();
+        return m_children.begin();
+    }
+    FLATTEN_INLINE std::pmr::vector<element>::iterator begin()
+    {
+        expand_if_lazy();
+        return m_children.begin();
+    }
+    FLATTEN_INLINE std::pmr::vector<element>::const_iterator end() const
+    {
+        expand_if_lazy();
+        return m_children.end();
+    }
+    FLATTEN_INLINE std::pmr::vector<element>::iterator end()
+    {
+        expand_if_lazy();
+        return m_children.end();
+    }
+
+    FLATTEN_INLINE std::pmr::vector<element>::size_type size() const
+    {
+        expand_if_lazy();
+        return m_children.size();
+    }
+    /// return true if this Element has no children
+    FLATTEN_INLINE bool empty() const { return size() == 0; }
+    /// delete all children
+    FLATTEN_INLINE void clear()
+    {
+        m_flags &= ~F_LAZY;
+        m_children.clear();
+        m_key_index.clear();
+    }
+    /// return true if this Element contains a child with a given name
+    FLATTEN_INLINE bool contains(std::string_view name) const
+    {
+        size_t position = find_child(name);
+        return position < m_children.size();
+    }
+    /// return true if this Element contains a child with a given name
+    FLATTEN_INLINE bool contains(const char* name) const { return contains(std::string_view(name)); }
+    /// return true if this Element contains a child with a given name
+    FLATTEN_INLINE bool contains(const std::string& name) const { return contains(std::string_view(name)); }
+    /// return true if this Element contains a child with a given name
+    FLATTEN_INLINE bool contains(const property_key& name) const
+    {
+        size_t position = find_child(name);
+        return position < m_children.size();
+    }
+
+    // write API
+
+    /// add new property to the `this`. return ref to `this`
+    /// @return reference to `this`
+    element& add_property(const std::string& name, double value);
+
+    /// add new property to the `this`. return ref to `this`
+    /// @return reference to `this`
+    element& add_property(const std::string& name, int value);
+
+    /// add new property to the `this`. return ref to `this`
+    /// @return reference to `this`
+    element& add_property(const std::string& name, long value);
+
+    /// add new property to the `this`. return ref to `this`
+    /// @return reference to `this`
+    element& add_property(const std::string& name, size_t value);
+
+    /// add new property to the `this`. return ref to `this`
+    /// @return reference to `this`
+    element& add_property(const std::string& name, const std::string& value);
+
+    /// add new property to the `this`. return ref to `this`
+    /// @return reference to `this`
+    element& add_property(const std::string& name, const char* value);
+
+    /// add new property to the `this`. return ref to `this`
+    /// @return reference to `this`
+    element& add_property(const std::string& name, bool b);
+
+    /// add new property to the `this`. return ref to `this`
+    /// @return reference to `this`
+    element& add_element(element&& elem);
+
+    /// add new property to the `this`. return ref to `this`
+    /// @return reference to `this`
+    element& add_property_null(const std::string& name);
+
+    /// add new array with a given name. return the newly added Element
+    /// @return the newly added object
+    element& add_array(const std::string& name);
+
+    /// add new object with a given name. return the newly added Element
+    /// @return the newly added object
+    element& add_object(const std::string& name);
+
+    /// add an Element of type string to the array, return the array
+    /// @return reference to `this`
+    element& add_array_item(const std::string& value);
+
+    /// add an Element of type string to the array, return the array
+    /// @return reference to `this`
+    element& add_array_item(const char* value);
+
+    /// add an Element of type double to the array, return the array
+    /// @return reference to `this`
+    element& add_array_item(double value);
+
+    /// add an Element of type integer to the array, return the array
+    /// @return reference to `this`
+    element& add_array_item(int value);
+
+    /// add an Element of type integer to the array, return the array
+    /// @return reference to `this`
+    element& add_array_item(long value);
+
+    /// add an Element of type integer to the array, return the array
+    /// @return reference to `this`
+    element& add_array_item(size_t value);
+
+    /// add an Element of type bool to the array, return the array
+    /// @return reference to `this`
+    element& add_array_item(bool b);
+
+    /// add an Element of type string to the array, return the array
+    /// @return reference to `this`
+    element& add_array_item(element elem);
+
+    /// create new empty Element of type object and append it to the end of the array
+    /// @return the newly added object
+    element& add_array_object();
+
+    /// return the property name or nullptr if this element has no name. For elements parsed with
+    /// `parse_view` this makes a NULL terminated copy of the name, use `property_name_view` instead
+    FLATTEN_INLINE const char* property_name() const
+    {
+        if (m_flags & (F_UNTERMINATED_NAME | F_ESCAPED_NAME)) {
+            const_cast<element*>(this)->decode_property_name();
+        }
+        return m_property_name;
+    }
+
+    /// return the property name without copying it. Empty if this element has no name
+    FLATTEN_INLINE std::string_view property_name_view() const
+    {
+        if (m_flags & F_ESCAPED_NAME) {
+            const_cast<element*>(this)->decode_property_name();
+        }
+        return { m_property_name, m_property_name_len };
+    }
+
+    /// return true if this element has a name (an object member)
+    FLATTEN_INLINE bool has_property_name() const { return m_property_name != nullptr; }
+
+    /// write this element to `ss` with `depth` levels of indentation (when `pretty` is set)
+    void to_string(std::ostream& ss, int depth, bool last_child, bool pretty) const;
+};
+
+/// The read-only content of a whole file. The file is memory mapped (and read ahead sequentially), so its
+/// content is never copied to the heap. Where `mmap` is not available, it is read into memory instead
+class mapped_file
+{
+public:
+    mapped_file() = default;
+    ~mapped_file();
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    /// map `path`, releasing the previous file. Return false if it can not be opened or read
+    bool open(const std::string& path);
+    void close();
+
+    /// the content of the file, an empty (but not NULL) view for an empty file
+    FLATTEN_INLINE std::string_view view() const { return { m_data ? m_data : "", m_size }; }
+
+private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_mapped = false;
+    /// the content, when the file is not mapped
+    std::string m_buffer;
+};
+
+/// A JSON tree that owns an arena (bump allocator). All the strings, property names and children
+/// lists of the tree are carved out of the arena, so parsing does not hit `malloc` per node and the
+/// whole tree is released in one step when the document is destroyed (or re-parsed)
+struct document {
+private:
+    /// the file parsed by `parse_file_view`, the tree's strings point into it (so it is destroyed last)
+    mapped_file m_file;
+    /// the arenas of the subtrees built by `parse_parallel`, one per batch of elements (destroyed after the tree)
+    std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource>> m_batch_arenas;
+    std::pmr::monotonic_buffer_resource m_arena;
+    element m_root;
+
+    /// drop the current tree and rewind the arena
+    void reset();
+
+public:
+    /// @param initial_size size of the first arena block. Following blocks grow geometrically
+    explicit document(size_t initial_size = 64 * 1024);
+    ~document() = default;
+
+    document(const document& other) = delete;
+    document& operator=(const document& other) = delete;
+
+    /// construct the document from string, see `element::parse`. Any previous content is released
+    parse_result parse(std::string_view content);
+    FLATTEN_INLINE parse_result parse(const char* data, size_t length) { return parse(std::string_view(data, length)); }
+
+    /// same as `parse`, but when the input is a large array its elements are parsed by `threads` threads
+    /// (`0` for one per core) and then placed in the root, in order. Other inputs are parsed on the calling thread
+    parse_result parse_parallel(std::string_view content, size_t threads = 0);
+
+    /// construct the document in-situ from a mutable buffer, see `element::parse_insitu`.
+    /// Any previous content is released. `buffer` must outlive the document's tree
+    parse_result parse_insitu(char* buffer, size_t length);
+
+    /// construct the document from a read-only buffer without copying its strings, see `element::parse_view`.
+    /// Any previous content is released. `content` must outlive the document's tree
+    parse_result parse_view(std::string_view content);
+
+    /// construct the document from a read-only buffer, parsing its arrays and objects only when they are
+    /// accessed, see `element::parse_lazy`. Any previous content is released. `content` must outlive the
+    /// document's tree
+    parse_result parse_lazy(std::string_view content);
+
+    /// construct the document from file. Any previous content is released
+    parse_result parse_file(const std::string& path);
+
+    /// construct the document from file without copying it: the file is memory mapped and parsed like
+    /// `parse_view`, so the strings point into the mapping. The document keeps the file mapped until it
+    /// is parsed again or destroyed. Any previous content is released
+    parse_result parse_file_view(const std::string& path);
+
+    /// the root element, use the regular `element` API to read (or extend) it
+    FLATTEN_INLINE const element& root() const { return m_root; }
+    FLATTEN_INLINE element& root() { return m_root; }
+};
+
+class tape_document;
+struct tape_builder;
+
+/// A node of a `tape_document`, 16 bytes. The children of an array or an object are stored next to each other
+struct tape_node {
+    static constexpr uint32_t NO_KEY = UINT32_MAX;
+
+    element_kind kind = element_kind::T_INVALID;
+    /// the offset of the member's name in the string pool (as a 32 bit length followed by the name),
+    /// `NO_KEY` for array items and for the root
+    uint32_t key = NO_KEY;
+    union {
+        /// numbers and booleans
+        element_value value;
+        /// strings: their bytes in the string pool. Arrays and objects: their children in the nodes array
+        struct {
+            uint32_t offset;
+            uint32_t length;
+        } range;
+    };
+};
+
+/// A read-only handle to a node of a `tape_document`, with the same read API as `element`. It is cheap to copy
+/// and valid until the document is parsed again or destroyed. Missing children are returned as an invalid handle
+/// (`is_ok()` returns false)
+class tape_element : public value_reader<tape_element>
+{
+    friend struct value_reader<tape_element>;
+    friend class tape_document;
+
+public:
+    /// iterate over the children of an array or an object
+    class iterator
+    {
+    public:
+        FLATTEN_INLINE iterator(const tape_document* doc, const tape_node* node)
+            : m_doc(doc)
+            , m_node(node)
+        {
+        }
+        FLATTEN_INLINE tape_element operator*() const { return tape_element(m_doc, m_node); }
+        FLATTEN_INLINE iterator& operator++()
+        {
+            ++m_node;
+            return *this;
+        }
+        FLATTEN_INLINE bool operator==(const iterator& other) const { return m_node == other.m_node; }
+        FLATTEN_INLINE bool operator!=(const iterator& other) const { return m_node != other.m_node; }
+
+    private:
+        const tape_document* m_doc = nullptr;
+        const tape_node* m_node = nullptr;
+    };
+
+    tape_element() = default;
+
+    FLATTEN_INLINE element_kind kind() const { return m_node ? m_node->kind : element_kind::T_INVALID; }
+
+    /// the number of children of an array or an object
+    FLATTEN_INLINE size_t size() const { return is_array() || is_object() ? m_node->range.length : 0; }
+    FLATTEN_INLINE bool empty() const { return size() == 0; }
+
+    iterator begin() const;
+    iterator end() const;
+
+    /// access a child by position, in `O(1)`
+    tape_element operator[](size_t index) const;
+    FLATTEN_INLINE tape_element operator[](int index) const { return operator[](static_cast<size_t>(index)); }
+
+    /// access a member by name. The members are scanned in order
+    tape_element operator[](std::string_view name) const;
+    FLATTEN_INLINE tape_element operator[](const char* name) const { return operator[](std::string_view(name)); }
+    FLATTEN_INLINE bool contains(std::string_view name) const { return operator[](name).is_ok(); }
+
+    /// return true if this element has a name (an object member)
+    FLATTEN_INLINE bool has_property_name() const { return m_node && m_node->key != tape_node::NO_KEY; }
+    /// return the property name. Empty if this element has no name
+    std::string_view property_name_view() const;
+
+private:
+    FLATTEN_INLINE tape_element(const tape_document* doc, const tape_node* node)
+        : m_doc(doc)
+        , m_node(node)
+    {
+    }
+
+    FLATTEN_INLINE const element_value& value() const { return m_node->value; }
+    std::string_view str_view() const;
+
+    const tape_document* m_doc = nullptr;
+    const tape_node* m_node = nullptr;
+};
+
+/// A parsed document in a compact, flat layout: fixed size nodes (see `tape_node`) in one array, where the
+/// children of every array and object are contiguous, and all the strings in one pool. It uses a fraction of the
+/// memory of an `element` tree and is faster to traverse, but it is read-only. Use `root()` to read it
+class tape_document
+{
+    friend class tape_element;
+    friend struct tape_builder;
+
+public:
+    /// parse `content`, replacing the previous document. The strings are copied (and decoded) into the pool
+    parse_result parse(std::string_view content);
+
+    /// the root element, invalid if the last parse failed
+    tape_element root() const;
+
+    /// the number of bytes allocated for the nodes and the strings
+    FLATTEN_INLINE size_t memory_usage() const
+    {
+        return m_nodes.capacity() * sizeof(tape_node) + m_strings.capacity();
+    }
+
+private:
+    /// the root is the first node
+    std::vector<tape_node> m_nodes;
+    std::string m_strings;
+};
+
+/// serialize `root` and append it to `out`. The text is written straight into `out`, so by reusing the same
+/// string no allocation is done once its capacity is large enough
+void to_string(const element& root, std::string* out, bool pretty = true);
+
+/// serialize `root` in chunks (of about 64KB), passing each chunk to `sink` as soon as it is ready
+void to_string(const element& root, const std::function<void(std::string_view)>& sink, bool pretty = true);
+
+/// serialize a `tape_document` (or a part of it), see `to_string(const element&, std::string*, bool)`
+void to_string(const tape_element& root, std::string* out, bool pretty = true);
+
+FLATTEN_INLINE void to_string(const element& root, std::ostream& ss, bool pretty = true)
+{
+    root.to_string(ss, 0, true, pretty);
+}
+
+/// For convenience. Same as calling `tinyjson::element::parse`
+FLATTEN_INLINE parse_result parse(std::string_view content, element* root) { return element::parse(content, root); }
+
+/// For convenience. Same as calling `tinyjson::element::parse`
+FLATTEN_INLINE parse_result parse(const char* data, size_t length, element* root)
+{
+    return element::parse(data, length, root);
+}
+
+/// For convenience. Same as calling `tinyjson::element::parse_insitu`
+FLATTEN_INLINE parse_result parse_insitu(char* buffer, size_t length, element* root)
+{
+    return element::parse_insitu(buffer, length, root);
+}
+
+/// For convenience. Same as calling `tinyjson::element::parse_view`
+FLATTEN_INLINE parse_result parse_view(std::string_view content, element* root)
+{
+    return element::parse_view(content, root);
+}
+
+/// For convenience. Same as calling `tinyjson::element::parse_lazy`
+FLATTEN_INLINE parse_result parse_lazy(std::string_view content, element* root)
+{
+    return element::parse_lazy(content, root);
+}
+
+/// For convenience. Same as calling `tinyjson::element::parse_file`
+FLATTEN_INLINE parse_result parse_file(const std::string& content, element* root)
+{
+    return element::parse_file(content, root);
+}
+
+/// walk `content` and report its values to `h` (see `tinyjson::handler`), without building a tree.
+/// Fail if the input is malformed or if one of the callbacks returned false (`parse_error::STOPPED`)
+parse_result parse(std::string_view content, handler* h);
+
+/// called for every NDJSON record, in input order. `index` counts the records (blank lines are not records).
+/// The record (and its strings, which point into the input) is only valid during the call. Return false to
+/// stop reading
+using ndjson_callback = std::function<bool(size_t index, const element& record)>;
+
+/// read newline delimited JSON (one value per line, blank lines are skipped) and pass every record to `callback`.
+/// With `threads > 1` (`0` for one per core), batches of records are parsed in parallel by a pool of threads,
+/// while the callback is still called on the calling thread and in input order.
+/// Fail if a record is malformed (the records before it are still reported) or if `callback` stopped
+/// (`parse_error::STOPPED`). The offset of the failure, and so its line, is relative to the whole of `content`
+parse_result parse_ndjson(std::string_view content, const ndjson_callback& callback, size_t threads = 1);
+
+/// same as `parse_ndjson` for a whole file, which is memory mapped (see `mapped_file`)
+parse_result parse_ndjson_file(const std::string& path, const ndjson_callback& callback, size_t threads = 1);
+
+/// called for every value matched by `query::select(content, callback)`, in input order. The value (and its
+/// strings, which point into the input) is only valid during the call. Return false to stop reading
+using query_callback = std::function<bool(const element& match)>;
+
+/// A path into JSON values, compiled once and then applied to any number of trees or inputs. Two syntaxes are
+/// accepted:
+///
+/// - RFC 6901 JSON Pointer, with `compile_pointer`: `/store/books/0/title` (`~0` and `~1` escape `~` and `/`)
+/// - a small path language, with `compile`: `$.store.books[*].title`, where every step is either `.name`,
+///   `['name']` (for names with special characters), `.*` or `[*]` (all members or items), `[2]` (an item) or
+///   `[start:end:step]` (a slice of items, where each part is optional and `end` is excluded)
+///
+/// Names are hashed at compile time, like `property_key`. Negative indices are not supported
+class query
+{
+public:
+    /// compile a JSON Pointer, replacing the previous query. Return false (and match nothing) if it is malformed
+    bool compile_pointer(std::string_view pointer);
+
+    /// compile a path expression (see above), replacing the previous query. Return false (and match nothing) if
+    /// it is malformed
+    bool compile(std::string_view path);
+
+    /// true if the query can match at most one value (it has no wildcard and no slice)
+    FLATTEN_INLINE bool is_single() const { return m_single; }
+
+    /// append the values of `root` matched by the query to `matches`, in document order
+    void select(const element& root, std::vector<const element*>* matches) const;
+    void select(const tape_element& root, std::vector<tape_element>* matches) const;
+
+    /// return the first value of `root` matched by the query, or an invalid element (`is_ok()` returns false)
+    const element& first(const element& root) const;
+    tape_element first(const tape_element& root) const;
+
+    /// run the query while parsing `content`, without building a tree: only the matched values are built and
+    /// passed to `callback`, the other arrays and objects are skipped over by matching their brackets (so, like
+    /// with `parse_lazy`, they are not validated). A single match query stops reading after its match.
+    /// Fail if the query is invalid (`parse_error::INVALID_QUERY`), if the input is malformed or if `callback`
+    /// stopped (`parse_error::STOPPED`)
+    parse_result select(std::string_view content, const query_callback& callback) const;
+
+    /// a step of the query, it selects children of the current value
+    struct step {
+        /// select the object member named `name` (with its hash)
+        bool by_name = false;
+        /// select all the object members
+        bool all_members = false;
+        std::string name;
+        uint32_t hash = 0;
+        /// select the array items in `[first, last)`, every `stride` items. Empty when `first == last`
+        size_t first = 0;
+        size_t last = 0;
+        size_t stride = 1;
+
+        FLATTEN_INLINE property_key key() const { return property_key(name, hash); }
+        FLATTEN_INLINE bool selects_item(size_t index) const
+        {
+            return index >= first && index < last && (index - first) % stride == 0;
+        }
+    };
+
+    FLATTEN_INLINE const std::vector<step>& steps() const { return m_steps; }
+
+private:
+    /// a query that matches nothing, when the last compile failed
+    bool m_valid = false;
+    bool m_single = true;
+    std::vector<step> m_steps;
+
+    /// end a successful compile
+    bool finish_compile();
+
+    /// pass the values of `value` matched by the steps from `depth` to `output`, until it returns false.
+    /// Return false if it did
+    template <typename Element, typename Output>
+    bool collect(const Element& value, size_t depth, Output&& output) const;
+};
+
+struct push_state;
+
+/// Incremental parser for input that arrives in chunks (e.g. from a socket). Call `feed` for every chunk as it
+/// arrives and `finish` once the input is complete. The values are reported as soon as they are complete, even
+/// when a string, a number or an escape sequence is split between chunks. Only the part of a token that spans
+/// chunks is copied, so memory use does not depend on the input size (unless building a tree)
+class push_parser
+{
+public:
+    /// report the values to `h`, see `tinyjson::handler`
+    explicit push_parser(handler* h);
+    /// build the tree into `root` (e.g. `document::root()`)
+    explicit push_parser(element* root);
+    ~push_parser();
+
+    push_parser(const push_parser&) = delete;
+    push_parser& operator=(const push_parser&) = delete;
+
+    /// parse the next `length` bytes of the input. Fail if the input is malformed (so far), if it exceeds the
+    /// `parse_limits` or if a handler callback returned false. Once it failed, the parser ignores the rest of the
+    /// input
+    parse_result feed(const char* data, size_t length);
+    FLATTEN_INLINE parse_result feed(std::string_view data) { return feed(data.data(), data.length()); }
+
+    /// signal the end of the input. Succeed if it was a single, complete JSON value
+    parse_result finish();
+
+private:
+    std::unique_ptr<push_state> m_state;
+};
+
+/// Typed binding: parse straight into C++ types and serialize them, without building a tree.
+///
+/// Supported types are `bool`, the integer and floating point types, `std::string`, `std::vector<T>`,
+/// `std::optional<T>` (`null` resets it) and structs that list their members in a `binding` specialization,
+/// usually with `TINYJSON_BIND`. Members missing from the input are left untouched and unknown members are
+/// skipped. A value of the wrong type (e.g. a string for an `int`, or a number out of its range) fails the parse.
+/// Integer members only accept integer literals
+template <typename T> struct binding;
+
+/// a member of a bound struct: its name (with its hash computed at compile time) and the pointer to the member
+template <typename Class, typename Member> struct binding_field {
+    property_key key;
+    Member Class::*member;
+};
+
+/// describe the member `member` named `name`, for `binding<Class>::fields`
+template <typename Class, typename Member>
+constexpr binding_field<Class, Member> field(std::string_view name, Member Class::*member)
+{
+    return { property_key(name), member };
+}
+
+struct bind_ops;
+
+/// a value being filled by the parser: the object and the operations of its type. Members that are skipped have
+/// no operations
+struct bind_target {
+    void* object = nullptr;
+    const bind_ops* ops = nullptr;
+};
+
+/// the operations through which the parser fills a value of a bound type, one per parse event. Each returns
+/// false when the type does not accept the event
+struct bind_ops {
+    bool (*null_value)(void* object);
+    bool (*bool_value)(void* object, bool value);
+    bool (*int64_value)(void* object, int64_t value);
+    bool (*uint64_value)(void* object, uint64_t value);
+    bool (*double_value)(void* object, double value);
+    bool (*string_value)(void* object, std::string_view value);
+    /// the value is an object, set `frame` to the target that receives its members
+    bool (*start_object)(void* object, bind_target* frame);
+    /// set `member` to the target that receives the value of the member `name`
+    bool (*key)(void* object, std::string_view name, bind_target* member);
+    /// the value is an array, set `frame` to the target that receives its items
+    bool (*start_array)(void* object, bind_target* frame);
+    /// set `item` to the target that receives the next item of the array
+    bool (*next_item)(void* object, bind_target* item);
+};
+
+/// parse `content` into `root`, see `from_json`
+parse_result parse(std::string_view content, bind_target root);
+
+/// append `str` to `out` as a quoted and escaped JSON string
+void append_json_string(std::string_view str, std::string* out);
+
+/// append `value` to `out` as a JSON number (`null` if it is not finite)
+void append_json_number(double value, std::string* out);
+
+/// the parse events that a type does not accept
+struct bind_rejects {
+    static bool null_value(void*) { return false; }
+    static bool bool_value(void*, bool) { return false; }
+    static bool int64_value(void*, int64_t) { return false; }
+    static bool uint64_value(void*, uint64_t) { return false; }
+    static bool double_value(void*, double) { return false; }
+    static bool string_value(void*, std::string_view) { return false; }
+    static bool start_object(void*, bind_target*) { return false; }
+    static bool key(void*, std::string_view, bind_target*) { return false; }
+    static bool start_array(void*, bind_target*) { return false; }
+    static bool next_item(void*, bind_target*) { return false; }
+};
+
+template <typename T, typename Enable = void> struct bind_traits;
+
+/// the operations implemented by `traits` (usually `bind_traits<T>`)
+template <typename traits> const bind_ops* bind_ops_from()
+{
+    static constexpr bind_ops OPS = { &traits::null_value, &traits::bool_value, &traits::int64_value,
+        &traits::uint64_value, &traits::double_value, &traits::string_value, &traits::start_object, &traits::key,
+        &traits::start_array, &traits::next_item };
+    return &OPS;
+}
+
+/// the operations of `T`, see `bind_traits`
+template <typename T> const bind_ops* bind_ops_of() { return bind_ops_from<bind_traits<T>>(); }
+
+/// how `T` is parsed and written. The primary template handles the structs described by `binding<T>`
+template <typename T, typename Enable> struct bind_traits : bind_rejects {
+    static bool start_object(void* object, bind_target* frame)
+    {
+        *frame = { object, bind_ops_of<T>() };
+        return true;
+    }
+
+    static bool key(void* object, std::string_view name, bind_target* member)
+    {
+        // unknown members are skipped
+        *member = {};
+        uint32_t hash = hash_property_name(name);
+        T& value = *static_cast<T*>(object);
+        std::apply([&](const auto&... fields) { (match(value, fields, name, hash, member) || ...); },
+                   binding<T>::fields);
+        return true;
+    }
+
+    template <typename Class, typename Member>
+    FLATTEN_INLINE static bool match(T& value, const binding_field<Class, Member>& field, std::string_view name,
+                                     uint32_t hash, bind_target* member)
+    {
+        if (field.key.hash() != hash || field.key.name() != name) {
+            return false;
+        }
+        *member = { &(value.*field.member), bind_ops_of<Member>() };
+        return true;
+    }
+
+    static void write(const T& value, std::string* out)
+    {
+        out->push_back('{');
+        bool first = true;
+        std::apply(
+            [&](const auto&... fields) {
+                auto write_field = [&](const auto& field) {
+                    if (!first) {
+                        out->push_back(',');
+                    }
+                    first = false;
+                    append_json_string(field.key.name(), out);
+                    out->push_back(':');
+                    using member_type = std::decay_t<decltype(value.*field.member)>;
+                    bind_traits<member_type>::write(value.*field.member, out);
+                };
+                (write_field(fields), ...);
+            },
+            binding<T>::fields);
+        out->push_back('}');
+    }
+};
+
+template <> struct bind_traits<bool> : bind_rejects {
+    static bool bool_value(void* object, bool value)
+    {
+        *static_cast<bool*>(object) = value;
+        return true;
+    }
+
+    static void write(bool value, std::string* out) { out->append(value ? "true" : "false"); }
+};
+
+template <typename T>
+struct bind_traits<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>> : bind_rejects {
+    static bool int64_value(void* object, int64_t value)
+    {
+        if constexpr (std::is_signed_v<T>) {
+            if (value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max()) {
+                return false;
+            }
+        } else {
+            if (value < 0 || static_cast<uint64_t>(value) > std::numeric_limits<T>::max()) {
+                return false;
+            }
+        }
+        *static_cast<T*>(object) = static_cast<T>(value);
+        return true;
+    }
+
+    static bool uint64_value(void* object, uint64_t value)
+    {
+        if (value > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+            return false;
+        }
+        *static_cast<T*>(object) = static_cast<T>(value);
+        return true;
+    }
+
+    static void write(T value, std::string* out)
+    {
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out->append(buffer, result.ptr - buffer);
+    }
+};
+
+template <typename T> struct bind_traits<T, std::enable_if_t<std::is_floating_point_v<T>>> : bind_rejects {
+    static bool int64_value(void* object, int64_t value)
+    {
+        *static_cast<T*>(object) = static_cast<T>(value);
+        return true;
+    }
+
+    static bool uint64_value(void* object, uint64_t value)
+    {
+        *static_cast<T*>(object) = static_cast<T>(value);
+        return true;
+    }
+
+    static bool double_value(void* object, double value)
+    {
+        *static_cast<T*>(object) = static_cast<T>(value);
+        return true;
+    }
+
+    static void write(T value, std::string* out) { append_json_number(static_cast<double>(value), out); }
+};
+
+template <> struct bind_traits<std::string> : bind_rejects {
+    static bool string_value(void* object, std::string_view value)
+    {
+        static_cast<std::string*>(object)->assign(value.data(), value.length());
+        return true;
+    }
+
+    static void write(const std::string& value, std::string* out) { append_json_string(value, out); }
+};
+
+template <typename T> struct bind_traits<std::vector<T>> : bind_rejects {
+    /// the items of a `std::vector<bool>`, which can not be addressed: the vector itself receives them
+    struct bool_item : bind_rejects {
+        static bool bool_value(void* object, bool value)
+        {
+            static_cast<std::vector<bool>*>(object)->push_back(value);
+            return true;
+        }
+    };
+
+    static bool start_array(void* object, bind_target* frame)
+    {
+        static_cast<std::vector<T>*>(object)->clear();
+        *frame = { object, bind_ops_of<std::vector<T>>() };
+        return true;
+    }
+
+    static bool next_item(void* object, bind_target* item)
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            *item = { object, bind_ops_from<bool_item>() };
+        } else {
+            auto& items = *static_cast<std::vector<T>*>(object);
+            items.emplace_back();
+            *item = { &items.back(), bind_ops_of<T>() };
+        }
+        return true;
+    }
+
+    static void write(const std::vector<T>& value, std::string* out)
+    {
+        out->push_back('[');
+        for (size_t i = 0; i < value.size(); ++i) {
+            if (i) {
+                out->push_back(',');
+            }
+            bind_traits<T>::write(value[i], out);
+        }
+        out->push_back(']');
+    }
+};
+
+template <typename T> struct bind_traits<std::optional<T>> {
+    /// the value of a (now) engaged optional
+    FLATTEN_INLINE static void* engage(void* object)
+    {
+        auto& optional = *static_cast<std::optional<T>*>(object);
+        if (!optional) {
+            optional.emplace();
+        }
+        return &*optional;
+    }
+
+    static bool null_value(void* object)
+    {
+        static_cast<std::optional<T>*>(object)->reset();
+        return true;
+    }
+    static bool bool_value(void* object, bool value) { return bind_traits<T>::bool_value(engage(object), value); }
+    static bool int64_value(void* object, int64_t value)
+    {
+        return bind_traits<T>::int64_value(engage(object), value);
+    }
+    static bool uint64_value(void* object, uint64_t value)
+    {
+        return bind_traits<T>::uint64_value(engage(object), value);
+    }
+    static bool double_value(void* object, double value)
+    {
+        return bind_traits<T>::double_value(engage(object), value);
+    }
+    static bool string_value(void* object, std::string_view value)
+    {
+        return bind_traits<T>::string_value(engage(object), value);
+    }
+    static bool start_object(void* object, bind_target* frame)
+    {
+        return bind_traits<T>::start_object(engage(object), frame);
+    }
+    static bool start_array(void* object, bind_target* frame)
+    {
+        return bind_traits<T>::start_array(engage(object), frame);
+    }
+    // the members and items go to the frame set by the engaged value, so these are never called
+    static bool key(void*, std::string_view, bind_target*) { return false; }
+    static bool next_item(void*, bind_target*) { return false; }
+
+    static void write(const std::optional<T>& value, std::string* out)
+    {
+        if (value) {
+            bind_traits<T>::write(*value, out);
+        } else {
+            out->append("null");
+        }
+    }
+};
+
+/// parse `content` straight into `value`, see `binding`. Fail if the input is malformed or does not match the
+/// type of `value` (`parse_error::STOPPED`), which is then partially filled
+template <typename T> parse_result from_json(std::string_view content, T* value)
+{
+    return parse(content, bind_target{ value, bind_ops_of<T>() });
+}
+
+/// serialize `value` (compact) and append it to `out`, see `binding`
+template <typename T> void to_json(const T& value, std::string* out) { bind_traits<T>::write(value, out); }
+
+} // namespace tinyjson
+
+#define TINYJSON_EXPAND(x) x
+#define TINYJSON_FOR_EACH_1(macro, type, x) macro(type, x)
+#define TINYJSON_FOR_EACH_2(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_1(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_3(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_2(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_4(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_3(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_5(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_4(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_6(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_5(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_7(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_6(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_8(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_7(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_9(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_8(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_10(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_9(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_11(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_10(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_12(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_11(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_13(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_12(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_14(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_13(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_15(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_14(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_16(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_15(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_17(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_16(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_18(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_17(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_19(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_18(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_20(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_19(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_21(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_20(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_22(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_21(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_23(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_22(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_24(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_23(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_25(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_24(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_26(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_25(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_27(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_26(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_28(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_27(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_29(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_28(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_30(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_29(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_31(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_30(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_32(macro, type, x, ...) \
+    macro(type, x), TINYJSON_EXPAND(TINYJSON_FOR_EACH_31(macro, type, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_SELECT(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, name, ...) name
+/// expand to `macro(type, x)` for every `x` of the arguments (up to 32), separated by commas
+#define TINYJSON_FOR_EACH(macro, type, ...) \
+    TINYJSON_EXPAND(TINYJSON_FOR_EACH_SELECT(__VA_ARGS__, TINYJSON_FOR_EACH_32, TINYJSON_FOR_EACH_31, TINYJSON_FOR_EACH_30, TINYJSON_FOR_EACH_29, TINYJSON_FOR_EACH_28, TINYJSON_FOR_EACH_27, TINYJSON_FOR_EACH_26, TINYJSON_FOR_EACH_25, TINYJSON_FOR_EACH_24, TINYJSON_FOR_EACH_23, TINYJSON_FOR_EACH_22, TINYJSON_FOR_EACH_21, TINYJSON_FOR_EACH_20, TINYJSON_FOR_EACH_19, TINYJSON_FOR_EACH_18, TINYJSON_FOR_EACH_17, TINYJSON_FOR_EACH_16, TINYJSON_FOR_EACH_15, TINYJSON_FOR_EACH_14, TINYJSON_FOR_EACH_13, TINYJSON_FOR_EACH_12, TINYJSON_FOR_EACH_11, TINYJSON_FOR_EACH_10, TINYJSON_FOR_EACH_9, TINYJSON_FOR_EACH_8, TINYJSON_FOR_EACH_7, TINYJSON_FOR_EACH_6, TINYJSON_FOR_EACH_5, TINYJSON_FOR_EACH_4, TINYJSON_FOR_EACH_3, TINYJSON_FOR_EACH_2, TINYJSON_FOR_EACH_1)(macro, type, __VA_ARGS__))
+
+#define TINYJSON_BIND_FIELD(type, member) tinyjson::field(#member, &type::member)
+
+/// describe the members of the struct `type` (up to 32) for `from_json` and `to_json`, the JSON names are the
+/// member names. Use it at global scope:
+///
+///     struct point { double x; double y; };
+///     TINYJSON_BIND(point, x, y)
+#define TINYJSON_BIND(type, ...)                                                                                    \
+    template <> struct tinyjson::binding<type> {                                                                    \
+        static constexpr auto fields = std::make_tuple(TINYJSON_FOR_EACH(TINYJSON_BIND_FIELD, type, __VA_ARGS__));  \
+    };
+
+#endif // JSON_LITE_HPP